@@ -28,132 +28,75 @@ static void prompt() {
     cli.readLetter(handleCommand, 0);
 }
 
-/** callback for readDec */
-static constexpr int ADD_LEFT = 0;
-static constexpr int ADD_RIGHT = 1;
+/** form of two decimal integers */
 static constexpr uint32_t DEC_LIMIT = 999999999UL;
+static constexpr libcli::Field ADD_DEC[] PROGMEM = {
+        libcli::field::dec(DEC_LIMIT),
+        libcli::field::dec(DEC_LIMIT, 1),
+};
 
-static void handleAddDec(uint32_t value, uintptr_t context, State state) {
-    static uint32_t last_num;
+LIBCLI_FORMAT(ADD_DEC_RESULT, "\nadd integers: %u + %u = %u\n");
 
-    if (state == State::CLI_CANCEL) {
-        prompt();
-        return;
-    }
-    if (state == State::CLI_DELETE) {
-        if (context == ADD_LEFT)
-            return;
-        cli.backspace();
-        cli.readDec(handleAddDec, ADD_LEFT, DEC_LIMIT, last_num);
-        return;
-    }
-    if (context == ADD_LEFT) {
-        last_num = value;
-        if (state == State::CLI_SPACE) {
-            cli.readDec(handleAddDec, ADD_RIGHT, DEC_LIMIT);
-            return;
-        }
-        value = 1;
+static void handleAddDec(const libcli::Cli::Form &form, uintptr_t context, State state) {
+    (void)context;
+    if (state != State::CLI_CANCEL) {
+        const auto left = form.value(0);
+        const auto right = form.value(1);
+        cli.printFormat(ADD_DEC_RESULT, left, right, left + right);
     }
-
-    cli.println();
-    cli.print(F("add integers: "));
-    cli.printDec(last_num);
-    cli.print(F(" + "));
-    cli.printDec(value);
-    cli.print(F(" = "));
-    cli.printlnDec(last_num + value);
     prompt();
 }
 
-/** callback for readHex */
-static constexpr int HEX_WIDTH = 7;
+static libcli::FormBuffer<2> add_dec(ADD_DEC, handleAddDec, 0);
+
+/** form of two hexadecimal integers */
 static constexpr uint32_t HEX_LIMIT = 0x0FFFFFFFUL;
+static constexpr libcli::Field ADD_HEX[] PROGMEM = {
+        libcli::field::hex(HEX_LIMIT),
+        libcli::field::hex(HEX_LIMIT, 1),
+};
 
-static void handleAddHex(uint32_t value, uintptr_t context, State state) {
-    static uint32_t last_num;
+LIBCLI_FORMAT(ADD_HEX_RESULT, "\nadd hexadecimal: %7x + %7x = %7x\n");
 
-    if (state == State::CLI_CANCEL) {
-        prompt();
-        return;
-    }
-    if (state == State::CLI_DELETE) {
-        if (context == ADD_LEFT)
-            return;
-        cli.backspace();
-        cli.readHex(handleAddHex, ADD_LEFT, HEX_LIMIT, last_num);
-        return;
-    }
-    if (context == ADD_LEFT) {
-        last_num = value;
-        if (state == State::CLI_SPACE) {
-            cli.readHex(handleAddHex, ADD_RIGHT, HEX_LIMIT);
-            return;
-        }
-        value = 1;
+static void handleAddHex(const libcli::Cli::Form &form, uintptr_t context, State state) {
+    (void)context;
+    if (state != State::CLI_CANCEL) {
+        const auto left = form.value(0);
+        const auto right = form.value(1);
+        cli.printFormat(ADD_HEX_RESULT, left, right, left + right);
     }
-
-    cli.println();
-    cli.print(F("add hexadecimal: "));
-    cli.printHex(last_num, HEX_WIDTH);
-    cli.print(F(" + "));
-    cli.printHex(value, HEX_WIDTH);
-    cli.print(F(" = "));
-    cli.printlnHex(last_num + value, HEX_WIDTH);
     prompt();
 }
 
-/** callback for readHex and readDec */
-static constexpr int DUMP_ADDRESS = 0;
-static constexpr int DUMP_LENGTH = 1;
+static libcli::FormBuffer<2> add_hex(ADD_HEX, handleAddHex, 0);
+
+/** form of address and length */
 static constexpr int DUMP_ADDR_WIDTH = 6;
 static constexpr uint32_t DUMP_ADDR_LIMIT = 0xFFFFFFUL;
+static constexpr libcli::Field DUMP[] PROGMEM = {
+        libcli::field::hex(DUMP_ADDR_LIMIT),
+        libcli::field::dec(UINT16_MAX, 16),
+};
 
-static void handleDump(uint32_t value, uintptr_t context, State state) {
-    static uint32_t last_addr;
+/** Pseudo memory whose content is the lower byte of its address. */
+static uint8_t readMemory(uint32_t address, uintptr_t context) {
+    (void)context;
+    return static_cast<uint8_t>(address);
+}
 
-    if (state == State::CLI_CANCEL) {
-        prompt();
-        return;
-    }
-    if (state == State::CLI_DELETE) {
-        if (context == DUMP_ADDRESS)
-            return;
-        cli.backspace();
-        cli.readHex(handleDump, DUMP_ADDRESS, DUMP_ADDR_LIMIT, last_addr);
-        return;
-    }
-    if (context == DUMP_ADDRESS) {
-        last_addr = value;
-        if (state == State::CLI_SPACE) {
-            cli.readDec(handleDump, DUMP_LENGTH, UINT16_MAX);
-            return;
-        }
-        value = 16;
-    }
+LIBCLI_FORMAT(DUMP_HEADER, "\ndump memory: %6x %u\n");
 
-    cli.println();
-    cli.print(F("dump memory: "));
-    cli.printHex(last_addr, DUMP_ADDR_WIDTH);
-    cli.print(' ');
-    cli.printlnDec(value);
-    const auto end = last_addr + value;
-    for (auto base = last_addr & ~0xF; base < end; base += 16) {
-        cli.printHex(base, DUMP_ADDR_WIDTH);
-        cli.print(F(": "));
-        for (auto i = 0; i < 16; i++) {
-            const auto a = base + i;
-            if (a < last_addr || a >= end) {
-                cli.printStr(F("_"), 4);
-            } else {
-                cli.printDec(static_cast<uint8_t>(a), 4);
-            }
-        }
-        cli.println();
+static void handleDump(const libcli::Cli::Form &form, uintptr_t context, State state) {
+    (void)context;
+    if (state != State::CLI_CANCEL) {
+        cli.printFormat(DUMP_HEADER, form.value(0), form.value(1));
+        cli.printDump(form.value(0), form.value(1), readMemory, 0, DUMP_ADDR_WIDTH);
     }
     prompt();
 }
 
+static libcli::FormBuffer<2> dump(DUMP, handleDump, 0);
+
 /** callback for readHex */
 static constexpr uint16_t MEMORY_ADDRESS = uint16_t(-1);
 static uint16_t MEMORY_INDEX(int index) {
@@ -210,14 +153,28 @@ static void handleMemory(uint32_t value, uintptr_t context, State state) {
 
 static char str_buffer[40];
 
-/** callback for readLine */
-static void handleLoad(char *line, uintptr_t context, State state) {
+/** sink of Intel HEX or S-record, which counts loaded bytes */
+static uint32_t load_bytes;
+
+LIBCLI_FORMAT(LOAD_RESULT, "load %u records, %u bytes, %u errors, start %6x\n");
+
+static void handleLoad(uint32_t address, const uint8_t *data, uint8_t size, uintptr_t context,
+        State state);
+
+static libcli::LoaderBuffer<32> loader(handleLoad, 0);
+
+static void handleLoad(uint32_t address, const uint8_t *data, uint8_t size, uintptr_t context,
+        State state) {
+    (void)data;
     (void)context;
-    if (state != State::CLI_CANCEL) {
-        cli.println();
-        cli.print(F("load file: '"));
-        cli.print(line);
-        cli.println('\'');
+    if (state == State::CLI_CONTINUE) {
+        load_bytes += size;
+        return;
+    }
+    if (state == State::CLI_CANCEL) {
+        cli.println(F("cancel"));
+    } else {
+        cli.printFormat(LOAD_RESULT, loader.records(), load_bytes, loader.errors(), address);
     }
     prompt();
 }
@@ -275,17 +232,18 @@ static void handleCommand(char letter, uintptr_t context) {
     }
     if (letter == 'a') {
         cli.print(F("add decimal "));
-        cli.readDec(handleAddDec, ADD_LEFT, DEC_LIMIT);
+        cli.readForm(add_dec);
         return;
     }
     if (letter == 'h') {
         cli.print(F("add hexadecimal "));
-        cli.readHex(handleAddHex, ADD_LEFT, HEX_LIMIT);
+        cli.readForm(add_hex);
         return;
     }
     if (letter == 'l') {
-        cli.print(F("load "));
-        cli.readLine(handleLoad, 0, str_buffer, sizeof(str_buffer));
+        cli.println(F("load Intel HEX or S-record"));
+        load_bytes = 0;
+        cli.readRecords(loader);
         return;
     }
     if (letter == 'w') {
@@ -295,7 +253,7 @@ static void handleCommand(char letter, uintptr_t context) {
     }
     if (letter == 'd') {
         cli.print(F("dump "));
-        cli.readHex(handleDump, DUMP_ADDRESS, DUMP_ADDR_LIMIT);
+        cli.readForm(dump);
         return;
     }
     if (letter == 'm') {
@@ -311,7 +269,7 @@ static void handleCommand(char letter, uintptr_t context) {
         cli.println(F("  s: step"));
         cli.println(F("  a: add decimal"));
         cli.println(F("  h: add hexadecimal"));
-        cli.println(F("  l: load <filename>"));
+        cli.println(F("  l: load <Intel HEX or S-record>"));
         cli.println(F("  w: word <word>..."));
         cli.println(F("  d: dump <address> <length>"));
         cli.print(F("  m: memory <address> <byte>..."));
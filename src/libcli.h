@@ -26,6 +26,11 @@
 #define LIBCLI_VERSION_PATCH 2
 #define LIBCLI_VERSION_STRING "1.4.2"
 
+#include "libcli_command.h"
+#include "libcli_form.h"
+#include "libcli_printf.h"
+#include "libcli_str.h"
+#include "libcli_tokens.h"
 #include "libcli_types.h"
 
 #include "libcli/libcli_impl.h"
@@ -39,8 +44,110 @@ public:
 
     /** Initialize with |console| as command line interface. */
     void begin(Stream &console) { _impl.begin(console); }
-    /** Event loop; shold be called in Sketch's main loop(). */
-    void loop() { _impl.loop(); }
+    /**
+     * Use |buffer| which has |size| bytes to combine output to console. Buffered output is sent
+     * at newline, at the end of |loop|, or by |flush|, as many as console's |availableForWrite|
+     * allows. Passing nullptr disables buffering.
+     *
+     * When |blocking| is false, output never waits for console; bytes which don't fit in
+     * |buffer| are dropped and counted by |outputDropped|, and |loop| defers input while
+     * |backpressure| is true. Half of |size| should be enough for the longest echo back, such
+     * as redrawing a number, say 64 bytes.
+     *
+     * Pacing relies on console's |availableForWrite|. A console which has never reported
+     * room, such as a Stream which keeps Print's default that returns 0, is assumed not to
+     * implement it, and buffered output is sent all at once, which may block.
+     */
+    void setOutputBuffer(uint8_t *buffer, size_t size, bool blocking = true) {
+        _impl.output.setBuffer(buffer, size, blocking);
+    }
+    /**
+     * True when non-blocking output buffer is more than half full because console can't keep
+     * up. Input and its echo back are deferred until the buffer drains.
+     */
+    bool backpressure() const { return _impl.output.busy(); }
+    /** Number of output bytes dropped in non-blocking mode. */
+    uint32_t outputDropped() const { return _impl.output.dropped(); }
+    /**
+     * Read input from |ring| instead of console, so that an interrupt handler can put received
+     * bytes into |ring| while a callback is running. Passing nullptr reads from console again.
+     */
+    void setInputRing(Ring *ring) { _impl.input = ring; }
+    /**
+     * Accept binary frames by |framer| along with interactive input. A frame is dispatched to
+     * a handler of FrameBuffer's table without echo back. Passing nullptr disables frames.
+     */
+    void setFramer(Framer *framer) { _impl.setFramer(framer); }
+    /** Send a binary frame of |id| with |size| bytes of |data| as payload. */
+    size_t sendFrame(uint8_t id, const void *data, uint8_t size) {
+        return _impl.sendFrame(id, static_cast<const uint8_t *>(data), size);
+    }
+
+    /**
+     * ANSI terminal mode; backspace erases a field by a cursor movement and erase to end of
+     * line, which costs the same for any width. String input can be edited by cursor keys;
+     * left, right, Home and End, or Control-B, F, A and E.
+     */
+    void setAnsi(bool enable) { _impl.setAnsi(enable); }
+
+    /**
+     * Event loop; should be called in Sketch's main loop(). Returns CLI_CONSUMED when input is
+     * consumed, along with CLI_PENDING when more input or output is waiting, otherwise
+     * CLI_IDLE after calling the idle hook.
+     */
+    libcli::LoopStatus loop() { return _impl.loop(); }
+
+    /**
+     * Event loop which processes available input up to |maxBytes| bytes or |budget| micro
+     * seconds, zero means no limit. The loop also stops when a callback switches to another
+     * type of input. Returns the number of bytes consumed.
+     */
+    size_t loop(size_t maxBytes, uint32_t budget = 0) { return _impl.loop(maxBytes, budget); }
+
+    /**
+     * Call |hook| from |loop| when it is idle, so that the hook can put MCU to sleep until the
+     * next interrupt. Passing nullptr disables the hook. Sessions has its own hook instead.
+     */
+    void setIdleHook(libcli::IdleHook hook, uintptr_t context) {
+        _impl.idle = hook;
+        _impl.idle_context = context;
+    }
+    /**
+     * Wake from idle, which can be called from an interrupt handler, such as the one which puts
+     * a received byte into Ring.
+     */
+    void wake() { _impl.woken = true; }
+    /**
+     * True if |wake| is called since |loop| started. An idle hook should check this with
+     * interrupts disabled right before sleeping, so that no input waits for another interrupt.
+     */
+    bool awake() const { return _impl.woken; }
+
+    /**
+     * Feed |script| to input processing by |loop| as if it's typed on console, but without
+     * echo back, backspace redraw and padding; only what callbacks print is sent to console.
+     * |script| is read in place, so it must stay valid while |scriptRunning| is true. Console
+     * input resumes after the end of |script|.
+     */
+    void runScript(const char *script) { _impl.setScript(script, false); }
+    void runScript(const __FlashStringHelper *script) {
+        runScript_P(reinterpret_cast<const char *>(script));
+    }
+    void runScript_P(const /*PROGMEM*/ char *script_P) { _impl.setScript(script_P, true); }
+    bool scriptRunning() const { return _impl.script != nullptr; }
+
+#if defined(LIBCLI_STATS)
+    /**
+     * Instrumentation counters and latency histograms. Available only when LIBCLI_STATS is
+     * defined for the whole build, otherwise no counting code is compiled in. It changes the
+     * layout of Cli, so that the library and every sketch file must be compiled with the same
+     * definition, such as PlatformIO's build_flags; the Arduino IDE can't pass it to library
+     * sources.
+     */
+    using Stats = libcli::Stats;
+    const Stats &stats() { return _impl.getStats(); }
+    void resetStats() { _impl.resetStats(); }
+#endif
 
     /**
      * A state what terminates user input.
@@ -49,10 +156,78 @@ public:
      *   CLI_NEWLINE,  // an input is terminated by newline.
      *   CLI_DELETE,   // current input is canceled and back to previous.
      *   CLI_CANCEL,   // whole input is canceled.
+     *   CLI_CONTINUE, // a chunk of |readChunks| is full and the line continues.
      * };
      */
     using State = libcli::State;
 
+    /**
+     * What |loop| did; CLI_IDLE, or a bit set of CLI_CONSUMED and CLI_PENDING.
+     * enum LoopStatus : uint8_t {
+     *   CLI_IDLE = 0,      // no input is consumed nor waiting, and output is drained.
+     *   CLI_CONSUMED = 1,  // some input is consumed.
+     *   CLI_PENDING = 2,   // input is available or output is waiting to be sent.
+     * };
+     */
+    using LoopStatus = libcli::LoopStatus;
+
+    /** void (*IdleHook)(uintptr_t context); */
+    using IdleHook = libcli::IdleHook;
+
+    /**
+     * Single-producer single-consumer lock-free input ring; RingBuffer<SIZE> has the storage.
+     */
+    using Ring = libcli::Ring;
+
+    /**
+     * Receiver of binary frames; FrameBuffer<SIZE> has the storage and the table of
+     * FrameCommand {id, size, handler}, where
+     * void (*FrameHandler)(const Frame &frame, uintptr_t context);
+     */
+    using Framer = libcli::Framer;
+
+    /**
+     * Decoder of Intel HEX and S-record; LoaderBuffer<SIZE> has the storage of data in a record
+     * and calls back
+     * void (*RecordSink)(uint32_t address, const uint8_t *data, uint8_t size, uintptr_t context,
+     *         State state);
+     */
+    using Loader = libcli::Loader;
+
+    /**
+     * Splitter of a |readLine| buffer into up to |N| tokens in place, which has typed
+     * accessors hex, dec, num and keyword.
+     */
+    template <size_t N>
+    using Tokens = libcli::Tokens<N>;
+
+    /**
+     * A sequence of numeric fields; FormBuffer<N> has the values of a PROGMEM array of N Field,
+     * which is made by field::hex, field::dec and field::num, and calls back
+     * void (*FormCallback)(const Form &form, uintptr_t context, State state);
+     */
+    using Form = libcli::Form;
+
+    /**
+     * A string and its length in PROGMEM defined by LIBCLI_STR(name, text), which |printStr|
+     * pads without scanning its length.
+     */
+    using Str = libcli::Str;
+
+    /**
+     * A format string compiled by LIBCLI_FORMAT(name, text) which takes |N| arguments, and
+     * bit i of |S| is set if argument i is a string.
+     */
+    template <uint8_t N, uint32_t S = 0>
+    using Format = libcli::Format<N, S>;
+
+    /**
+     * Adapters from a member function to a callback; Member<T>::call<&T::method> with
+     * Member<T>::context(object), so that no handler has to cast |context| back.
+     */
+    template <typename T>
+    using Member = libcli::Member<T>;
+
     /**
      * Callback function of |readLetter|.
      * void (*LetterCallback)(char letter, uintptr_t context);
@@ -71,11 +246,58 @@ public:
      */
     using NumberCallback = libcli::NumberCallback;
 
+    /**
+     * Callback function of 64-bit |readHex|, |readDec| and |readNum|.
+     * void (*Number64Callback)(uint64_t number, uintptr_t context, State state);
+     */
+    using Number64Callback = libcli::Number64Callback;
+
+    /**
+     * Callback function of signed |readDec| and |readNum|.
+     * void (*SignedCallback)(int32_t number, uintptr_t context, State state);
+     */
+    using SignedCallback = libcli::SignedCallback;
+
+    /**
+     * Callback function of 64-bit signed |readDec| and |readNum|.
+     * void (*Signed64Callback)(int64_t number, uintptr_t context, State state);
+     */
+    using Signed64Callback = libcli::Signed64Callback;
+
+    /**
+     * Handler function of a command in CommandTable.
+     * void (*CommandHandler)(const char *name, uintptr_t context, State state);
+     */
+    using CommandHandler = libcli::CommandHandler;
+
+    /**
+     * A table of commands, which is defined by LIBCLI_COMMAND_TABLE(name, commands) from a
+     * constexpr array of up to COMMAND_TABLE_MAX (40) {name, handler} in PROGMEM.
+     */
+    using CommandTable = libcli::CommandTable;
+
+    /**
+     * A prefix trie of words in PROGMEM for completion, which is defined by
+     * LIBCLI_TRIE(name, words) from a constexpr array of sorted strings.
+     */
+    using Trie = libcli::Trie;
+
     /**
      * Read a single letter.
      */
     void readLetter(LetterCallback callback, uintptr_t context);
 
+    /**
+     * Read a single letter and call the handler of the matching command in |commands|.
+     */
+    void readLetter(const CommandTable &commands, uintptr_t context);
+
+    /**
+     * Read a command name delimitted by space into |buffer| which has |size| bytes, and call the
+     * handler of the matching command in |commands|.
+     */
+    void readWord(const CommandTable &commands, uintptr_t context, char *buffer, size_t size);
+
     /**
      * Read a string delimitted by space into |buffer| which has |size| bytes. If |hasDefval| is
      * true, |buffer| contains a default value.
@@ -83,12 +305,30 @@ public:
     void readWord(StringCallback callback, uintptr_t context, char *buffer, size_t size,
             bool hasDefval = false);
 
+    /**
+     * Read a word like above, where tab completes the input from |words| defined by
+     * LIBCLI_TRIE(name, words). Only the completed suffix is echoed back, and candidates are
+     * listed when the input is ambiguous.
+     */
+    void readWord(const CommandTable &commands, uintptr_t context, char *buffer, size_t size,
+            const Trie &words);
+    void readWord(StringCallback callback, uintptr_t context, char *buffer, size_t size,
+            const Trie &words, bool hasDefval = false);
+
     /**
      * Read a string delimitted by newline into |buffer| which has |size| bytes. If |hasDefval| is
      * true, |buffer| contains a default value.
      */
     void readLine(StringCallback callback, uintptr_t context, char *buffer, size_t size,
             bool hasDefval = false);
+
+    /**
+     * Read a line of any length in chunks of up to |size| - 1 chars through |buffer|. A full
+     * chunk is called back with CLI_CONTINUE and the rest of line follows, and the last chunk,
+     * which may be empty, with CLI_NEWLINE. Backspace can erase chars of the current chunk only.
+     */
+    void readChunks(StringCallback callback, uintptr_t context, char *buffer, size_t size);
+
     /**
      * Read hexadecimal number less or equals to |limit|.
      */
@@ -121,6 +361,113 @@ public:
     void readNum(NumberCallback callback, uintptr_t context, uint8_t radix, uint32_t limit,
             uint32_t defval);
 
+    /**
+     * Read 64-bit hexadecimal number less or equals to |limit|.
+     */
+    void readHex(Number64Callback callback, uintptr_t context, uint64_t limit = UINT64_MAX);
+
+    /**
+     * Read 64-bit hexadecimal number less or equals to |limit| with |defval| as default.
+     */
+    void readHex(Number64Callback callback, uintptr_t context, uint64_t limit, uint64_t defval);
+
+    /**
+     * Read 64-bit decimal number less or equal to |limit|.
+     */
+    void readDec(Number64Callback callback, uintptr_t context, uint64_t limit = UINT64_MAX);
+
+    /**
+     * Read 64-bit decimal number less or equal to |limit| with |defval| as default.
+     */
+    void readDec(Number64Callback callback, uintptr_t context, uint64_t limit, uint64_t defval);
+
+    /**
+     * Read 64-bit |radix| number less or equal to |limit|.
+     */
+    void readNum(Number64Callback callback, uintptr_t context, uint8_t radix = 10,
+            uint64_t limit = UINT64_MAX);
+
+    /**
+     * Read 64-bit |radix| number less or equal to |limit| with |defval| as default.
+     */
+    void readNum(Number64Callback callback, uintptr_t context, uint8_t radix, uint64_t limit,
+            uint64_t defval);
+
+    /**
+     * Read signed decimal number between |min| and |max|. A leading '-' is accepted when |min| is
+     * negative, and a number out of range isn't terminated by space nor newline.
+     */
+    void readDec(SignedCallback callback, uintptr_t context, int32_t min = INT32_MIN,
+            int32_t max = INT32_MAX);
+
+    /**
+     * Read signed decimal number between |min| and |max| with |defval| as default.
+     */
+    void readDec(
+            SignedCallback callback, uintptr_t context, int32_t min, int32_t max, int32_t defval);
+
+    /**
+     * Read signed |radix| number between |min| and |max|.
+     */
+    void readNum(SignedCallback callback, uintptr_t context, uint8_t radix, int32_t min = INT32_MIN,
+            int32_t max = INT32_MAX);
+
+    /**
+     * Read signed |radix| number between |min| and |max| with |defval| as default.
+     */
+    void readNum(SignedCallback callback, uintptr_t context, uint8_t radix, int32_t min,
+            int32_t max, int32_t defval);
+
+    /**
+     * Read 64-bit signed decimal number between |min| and |max|.
+     */
+    void readDec(Signed64Callback callback, uintptr_t context, int64_t min = INT64_MIN,
+            int64_t max = INT64_MAX);
+
+    /**
+     * Read 64-bit signed decimal number between |min| and |max| with |defval| as default.
+     */
+    void readDec(Signed64Callback callback, uintptr_t context, int64_t min, int64_t max,
+            int64_t defval);
+
+    /**
+     * Read 64-bit signed |radix| number between |min| and |max|.
+     */
+    void readNum(Signed64Callback callback, uintptr_t context, uint8_t radix,
+            int64_t min = INT64_MIN, int64_t max = INT64_MAX);
+
+    /**
+     * Read 64-bit signed |radix| number between |min| and |max| with |defval| as default.
+     */
+    void readNum(Signed64Callback callback, uintptr_t context, uint8_t radix, int64_t min,
+            int64_t max, int64_t defval);
+
+    /**
+     * Read signed fixed-point number between |min| and |max| with |fraction| digits after
+     * decimal point, which is scaled by 10^|fraction|; "-12.5" is -12500 when |fraction| is 3.
+     * Omitted fraction digits are 0. |fraction| more than FIXED_FRACTION_MAX, 9, is clamped.
+     */
+    void readFixed(SignedCallback callback, uintptr_t context, uint8_t fraction,
+            int32_t min = INT32_MIN, int32_t max = INT32_MAX);
+
+    /**
+     * Read signed fixed-point number between |min| and |max| with |defval| as default.
+     */
+    void readFixed(SignedCallback callback, uintptr_t context, uint8_t fraction, int32_t min,
+            int32_t max, int32_t defval);
+
+    /**
+     * Read numeric fields of |form| in sequence, and call back its FormCallback once the form is
+     * completed or canceled.
+     */
+    void readForm(Form &form) { form.begin(*this); }
+
+    /**
+     * Read Intel HEX or S-records into |loader| without echo back, until its RecordSink is
+     * called back with CLI_NEWLINE at the end of file or CLI_CANCEL.
+     */
+    void readRecords(Loader &loader) { _impl.setLoader(loader); }
+
     /**
      * Print |number| in 0-prefixed hexadecimal format of |width| chars. Negative |width| means left
      * aligned.
@@ -154,12 +501,25 @@ public:
      */
     size_t printlnNum(uint32_t number, uint8_t radix = 10, int8_t width = 0);
 
+    /**
+     * Print fixed-point |number| scaled by 10^|fraction| in right-aligned decimal format of
+     * |width| chars. Negative |width| means left aligned. |fraction| more than
+     * FIXED_FRACTION_MAX, 9, is clamped.
+     */
+    size_t printFixed(int32_t number, uint8_t fraction, int8_t width = 0);
+
+    /**
+     * Print fixed-point |number| in right-aligned decimal format of |width| chars and newline.
+     */
+    size_t printlnFixed(int32_t number, uint8_t fraction, int8_t width = 0);
+
     /*
      * Print |text| in right-aligned of |width| chars. Negative |width| means left-aligned.
      */
     size_t printStr(const __FlashStringHelper *text, int8_t width = 0);
     size_t printStr(const char *text, int8_t witdh = 0);
     size_t printStr_P(const /*PROGMEM*/ char *text_P, int8_t witdh = 0);
+    size_t printStr(const Str &str, int8_t width = 0);
 
     /*
      * Print |text| in right-aligned of |width| chars and newline.
@@ -167,6 +527,42 @@ public:
     size_t printlnStr(const __FlashStringHelper *text, int8_t width = 0);
     size_t printlnStr(const char *text, int8_t witdh = 0);
     size_t printlnStr_P(const /*PROGMEM*/ char *text_P, int8_t witdh = 0);
+    size_t printlnStr(const Str &str, int8_t width = 0);
+
+    /**
+     * Print |args| by |format| defined by LIBCLI_FORMAT(name, text), whose conversions are
+     * parsed at compile time. Up to 64 chars are sent with a single write. A string argument
+     * for other than %s, or a number for %s, is a compile error.
+     */
+    template <uint8_t N, uint32_t S, typename... Args>
+    size_t printFormat(const Format<N, S> &format, Args... args) {
+        static_assert(sizeof...(Args) == N, "number of arguments doesn't match format");
+        static_assert(libcli::format::Strings<Args...>::bits() == S,
+                "type of arguments doesn't match format");
+        const libcli::format::Arg list[N + 1] = {args...};
+        return _impl.printFormat(format.program, list);
+    }
+
+    /**
+     * Callback function of |printDump| to read a byte at |address|.
+     * uint8_t (*DumpReader)(uint32_t address, uintptr_t context);
+     */
+    using DumpReader = libcli::DumpReader;
+
+    /**
+     * Print |len| bytes of |data| in hexadecimal dump of 16 bytes per row, each row starts with
+     * |address| in |addrWidth| hexadecimal digits (0 omits it). An extra space separates every
+     * |group| bytes (0 for none), and |ascii| appends printable chars. Each row is sent with a
+     * single write.
+     */
+    size_t printDump(uint32_t address, const void *data, size_t len, int8_t addrWidth = 4,
+            uint8_t group = 8, bool ascii = true);
+
+    /**
+     * Print |len| bytes from |address| in hexadecimal dump, which are read by |reader|.
+     */
+    size_t printDump(uint32_t address, size_t len, DumpReader reader, uintptr_t context,
+            int8_t addrWidth = 4, uint8_t group = 8, bool ascii = true);
 
     /**
      * Print backspace |n| times.
@@ -197,6 +593,95 @@ private:
     impl::Impl _impl;
 };
 
+/**
+ * |N| independent command line sessions served from one event loop. Each session is a Cli
+ * which is bound to its own console by |begin|, and costs sizeof(Cli) bytes of RAM; 129 bytes
+ * on AVR and 224 bytes on 32-bit ARM without LIBCLI_STATS. The manager itself adds 8 and 16
+ * bytes respectively. No heap is used.
+ */
+template <uint8_t N>
+class Sessions final {
+public:
+    static_assert(N > 0, "no session");
+
+    Sessions() : _current(nullptr), _idle(nullptr), _idle_context(0), _next(0), _woken(false) {}
+
+    /** Number of sessions. */
+    static constexpr uint8_t size() { return N; }
+
+    /** Initialize session |index| with |console|. */
+    void begin(uint8_t index, Stream &console) { _sessions[index].begin(console); }
+
+    /** Session |index|. */
+    Cli &operator[](uint8_t index) { return _sessions[index]; }
+
+    /**
+     * Session whose input is being processed; callbacks can use this to find out their own
+     * session. nullptr outside of |loop|.
+     */
+    Cli *current() const { return _current; }
+
+    /**
+     * Call |hook| from |loop| when every session is idle. An idle hook must not be set on
+     * each session, since one sleeping in its hook stalls the others.
+     */
+    void setIdleHook(libcli::IdleHook hook, uintptr_t context) {
+        _idle = hook;
+        _idle_context = context;
+    }
+    /** Wake from idle; same as Cli::wake but for all sessions. */
+    void wake() { _woken = true; }
+    /** True if |wake| is called since |loop| started; same as Cli::awake. */
+    bool awake() const { return _woken; }
+
+    /**
+     * Event loop; shold be called in Sketch's main loop(). Each session processes at most
+     * one byte per round, up to |rounds| rounds, and the session to start a round rotates so
+     * that every session is served fairly. Returns the number of bytes consumed.
+     */
+    size_t loop(uint8_t rounds = 1) {
+        _woken = false;
+        size_t total = 0;
+        uint_fast8_t status = libcli::CLI_IDLE;
+        while (rounds-- > 0) {
+            size_t n = 0;
+            status = libcli::CLI_IDLE;
+            auto index = _next;
+            if (++_next == N)
+                _next = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                _current = &_sessions[index];
+                const auto s = _current->loop();
+                if (s & libcli::CLI_CONSUMED)
+                    n++;
+                status |= s;
+                if (++index == N)
+                    index = 0;
+            }
+            _current = nullptr;
+            if (n == 0)
+                break;
+            total += n;
+        }
+        if (status == libcli::CLI_IDLE && _idle)
+            _idle(_idle_context);
+        return total;
+    }
+
+private:
+    Cli _sessions[N];
+    Cli *_current;
+    libcli::IdleHook _idle;
+    uintptr_t _idle_context;
+    uint8_t _next;
+    volatile bool _woken;
+
+    /** No copy constructor. */
+    Sessions(Sessions const &) = delete;
+    /** No assignment operator. */
+    void operator=(Sessions const &) = delete;
+};
+
 }  // namespace libcli
 
 #endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_FAKE_BENCH_STREAM_H__
+#define __LIBCLI_FAKE_BENCH_STREAM_H__
+
+#include <stdio.h>
+#include <string.h>
+
+namespace libcli {
+namespace fake {
+
+/**
+ * A Stream for benchmarks. Input is |text| repeated up to |length| bytes and output is
+ * discarded but counted.
+ */
+class BenchStream : public Stream {
+public:
+    BenchStream() : Stream() {}
+
+    // Print
+    size_t write(uint8_t) override {
+        _written++;
+        return 1;
+    }
+
+    size_t write(const uint8_t *, size_t size) override {
+        _written += size;
+        return size;
+    }
+
+    // Stream
+    int available() override { return _remain > INT16_MAX ? INT16_MAX : _remain; }
+
+    int peek() override { return _remain ? _text[_index] : -1; }
+
+    int read() override {
+        if (_remain == 0)
+            return -1;
+        const auto c = _text[_index];
+        if (++_index == _length)
+            _index = 0;
+        _remain--;
+        return c;
+    }
+
+    // BenchStream
+    void setInput(const char *text, uint32_t length) {
+        _text = text;
+        _length = strlen(text);
+        _index = 0;
+        _remain = _length ? length : 0;
+    }
+
+    uint32_t written() const { return _written; }
+
+    void resetWritten() { _written = 0; }
+
+private:
+    const char *_text = "";
+    size_t _length = 0;
+    size_t _index = 0;
+    uint32_t _remain = 0;
+    uint32_t _written = 0;
+};
+
+/**
+ * Print a benchmark result in one line of "key=value" pairs, which is easy to parse by
+ * scripts; |name| and |params| identify the benchmark, |ops| operations took |us| micro
+ * seconds and wrote |bytes| bytes.
+ */
+inline void benchReport(const char *name, const char *params, uint32_t ops, uint32_t us,
+        uint32_t bytes) {
+    printf("bench=%s %s ops=%lu us=%lu ns_per_op=%.1f ops_per_sec=%.0f bytes_per_op=%.2f\n",
+            name, params, (unsigned long)ops, (unsigned long)us, ops ? us * 1000.0 / ops : 0.0,
+            us ? ops * 1e6 / us : 0.0, ops ? double(bytes) / ops : 0.0);
+}
+
+}  // namespace fake
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
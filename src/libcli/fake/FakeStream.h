@@ -17,58 +17,89 @@
 #ifndef __LIBCLI_FAKE_SERIAL_H__
 #define __LIBCLI_FAKE_SERIAL_H__
 
+#include <string.h>
+
 namespace libcli {
 namespace fake {
 
-class FakeStream : public Stream {
+/**
+ * A Stream for tests, whose input and output are preallocated arenas; FakeStreamBuffer has the
+ * storage. Input in RAM is copied into the input arena, and input in PROGMEM is read in place.
+ * Output which overflows the output arena is dropped.
+ */
+class BasicFakeStream : public Stream {
 public:
-    FakeStream() : Stream() {}
-
     // Print
-    size_t write(uint8_t data) override { return _printer.write((char)data); }
+    size_t write(uint8_t data) override {
+        if (_outLen == _outSize)
+            return 0;
+        _output[_outLen++] = data;
+        _output[_outLen] = 0;
+        return 1;
+    }
 
     size_t write(const uint8_t *data, size_t size) override {
-        return data ? _printer.write((const char *)data, size) : 0;
+        if (data == nullptr)
+            return 0;
+        if (size > _outSize - _outLen)
+            size = _outSize - _outLen;
+        memcpy(_output + _outLen, data, size);
+        _outLen += size;
+        _output[_outLen] = 0;
+        return size;
     }
 
+    int availableForWrite() override { return _writable; }
+
     void flush()
 #if defined(ESP32) || defined(ARDUINO_ARCH_STM32)
 #else
             override
 #endif
     {
-        _printer.clear();
+        _output[_outLen = 0] = 0;
     }
 
     // FakePrinter
-    const char *printerText() const {
-        return _printer.c_str();
-    }
+    /** Captured output, which is valid until next write or flush. */
+    const char *printerText() const { return _output; }
 
-    int printerLength() const {
-        return _printer.length();
-    }
+    int printerLength() const { return _outLen; }
 
     // Stream
     int available() override {
-        return _reader.available();
+        const auto remain = _inLen - _index;
+        return remain > INT16_MAX ? INT16_MAX : remain;
     }
 
     int peek() override {
-        return available() ? _reader.peek() : -1;
+        if (_index == _inLen)
+            return -1;
+        return _text_P ? pgm_read_byte(_text_P + _index) : _input[_index];
     }
 
     int read() override {
-        return available() ? _reader.read() : -1;
+        const auto c = peek();
+        if (c >= 0)
+            _index++;
+        return c;
     }
 
     // FakeStream
-    void setInput(char c) {
-        _reader.set(c);
-    }
+    void setAvailableForWrite(int writable) { _writable = writable; }
 
-    void setInput(const char *text) {
-        _reader.set(text);
+    void setInput(char c) { setInput(&c, 1); }
+
+    void setInput(const char *text) { setInput(text, strlen(text)); }
+
+    /** Input |size| bytes of |data|, which may contain NUL, up to the input arena size. */
+    void setInput(const char *data, uint32_t size) {
+        if (size > _inSize)
+            size = _inSize;
+        memcpy(_input, data, size);
+        _text_P = nullptr;
+        _inLen = size;
+        _index = 0;
     }
 
     void setInput(const __FlashStringHelper *text_P) {
@@ -76,72 +107,49 @@ public:
     }
 
     void setInput_P(const /*PROGMEM*/ char *text_P) {
-        _reader.set_P(text_P);
+        _text_P = text_P;
+        _inLen = strlen_P(text_P);
+        _index = 0;
     }
 
-private:
-    struct {
-        size_t write(char c) {
-            _buffer += c;
-            return sizeof(c);
-        }
-
-        size_t write(const char *text, const size_t size) {
-            _buffer.reserve(_buffer.length() + size);
-            for (const char *end = text + size; text < end; text++)
-                write(*text);
-            return size;
-        }
-
-        const char *c_str() const { return _buffer.c_str(); }
-
-        int length() const { return _buffer.length(); }
-
-        void clear() { _buffer = ""; }
-
-    private:
-        String _buffer;
-    } _printer;
+protected:
+    BasicFakeStream(char *input, uint32_t inSize, char *output, uint32_t outSize)
+        : Stream(), _input(input), _inSize(inSize), _output(output), _outSize(outSize) {
+        _output[0] = 0;
+    }
 
-    struct {
-        int available() const { return (_text_P ? _length_P : _buffer.length()) - _index; }
+private:
+    char *const _input;
+    const uint32_t _inSize;
+    /** Output arena, which has a room for terminating NUL. */
+    char *const _output;
+    const uint32_t _outSize;
+    const /*PROGMEM*/ char *_text_P = nullptr;
+    uint32_t _inLen = 0;
+    uint32_t _index = 0;
+    uint32_t _outLen = 0;
+    int _writable = INT16_MAX;
+
+    /** No copy constructor. */
+    BasicFakeStream(BasicFakeStream const &) = delete;
+    /** No assignment operator. */
+    void operator=(BasicFakeStream const &) = delete;
+};
 
-        int peek() const {
-            return _text_P ? pgm_read_byte(_text_P + _index) : _buffer.charAt(_index);
-        }
+/** FakeStream which can hold |INPUT| bytes of input and |OUTPUT| bytes of output. */
+template <uint32_t INPUT, uint32_t OUTPUT>
+class FakeStreamBuffer : public BasicFakeStream {
+public:
+    FakeStreamBuffer() : BasicFakeStream(_inStorage, INPUT, _outStorage, OUTPUT) {}
 
-        int read() {
-            const auto c = peek();
-            _index++;
-            return c;
-        }
-
-        void set(char c) {
-            _buffer = c;
-            _text_P = nullptr;
-            _index = 0;
-        }
-
-        void set(const char *text) {
-            _buffer = text;
-            _text_P = nullptr;
-            _index = 0;
-        }
-
-        void set_P(const /*PROGMEM*/ char *text_P) {
-            _text_P = text_P;
-            _length_P = strlen_P(text_P);
-            _index = 0;
-        }
-
-    private:
-        String _buffer;
-        const /*PROGMEM*/ char*_text_P = nullptr;
-        size_t _length_P = 0;
-        uint8_t _index = 0;
-    } _reader;
+private:
+    char _inStorage[INPUT];
+    char _outStorage[OUTPUT + 1];
 };
 
+/** FakeStream of the default capacity for unit tests. */
+using FakeStream = FakeStreamBuffer<1024, 8192>;
+
 }  // namespace fake
 }  // namespace libcli
 
@@ -39,6 +39,14 @@ size_t Cli::printNum(uint32_t number, uint8_t radix, int8_t width) {
     return _impl.printNum(number, width, radix, false);
 }
 
+size_t Cli::printFixed(int32_t number, uint8_t fraction, int8_t width) {
+    return _impl.printFixed(number, fraction, width, false);
+}
+
+size_t Cli::printlnFixed(int32_t number, uint8_t fraction, int8_t width) {
+    return _impl.printFixed(number, fraction, width, true);
+}
+
 size_t Cli::printStr(const __FlashStringHelper *text, int8_t width) {
     return _impl.printStr(text, width, false);
 }
@@ -51,6 +59,10 @@ size_t Cli::printStr_P(const /*PROGMEM*/ char *text_P, int8_t width) {
     return _impl.printStr(reinterpret_cast<const __FlashStringHelper *>(text_P), width, false);
 }
 
+size_t Cli::printStr(const Str &str, int8_t width) {
+    return _impl.printStr(str, width, false);
+}
+
 size_t Cli::printlnHex(uint32_t number, int8_t width) {
     return _impl.printNum(number, width, 16, true);
 }
@@ -75,6 +87,21 @@ size_t Cli::printlnStr_P(const /*PROGMEM*/ char *text_P, int8_t width) {
     return _impl.printStr(reinterpret_cast<const __FlashStringHelper *>(text_P), width, true);
 }
 
+size_t Cli::printlnStr(const Str &str, int8_t width) {
+    return _impl.printStr(str, width, true);
+}
+
+size_t Cli::printDump(uint32_t address, const void *data, size_t len, int8_t addrWidth,
+        uint8_t group, bool ascii) {
+    return _impl.printDump(address, len, static_cast<const uint8_t *>(data), nullptr, 0,
+            addrWidth, group, ascii);
+}
+
+size_t Cli::printDump(uint32_t address, size_t len, DumpReader reader, uintptr_t context,
+        int8_t addrWidth, uint8_t group, bool ascii) {
+    return _impl.printDump(address, len, nullptr, reader, context, addrWidth, group, ascii);
+}
+
 size_t Cli::backspace(int8_t n) {
     return _impl.backspace(n);
 }
@@ -83,16 +110,41 @@ void Cli::readLetter(LetterCallback callback, uintptr_t context) {
     _impl.setCallback(callback, context);
 }
 
+void Cli::readLetter(const CommandTable &commands, uintptr_t context) {
+    _impl.setCallback(&commands, context);
+}
+
+void Cli::readWord(
+        const CommandTable &commands, uintptr_t context, char *buffer, size_t size) {
+    _impl.setCallback(&commands, context, buffer, size);
+}
+
 void Cli::readWord(
         StringCallback callback, uintptr_t context, char *buffer, size_t size, bool hasDefval) {
     _impl.setCallback(callback, context, buffer, size, hasDefval, true);
 }
 
+void Cli::readWord(const CommandTable &commands, uintptr_t context, char *buffer, size_t size,
+        const Trie &words) {
+    _impl.setCallback(&commands, context, buffer, size);
+    _impl.setTrie(words);
+}
+
+void Cli::readWord(StringCallback callback, uintptr_t context, char *buffer, size_t size,
+        const Trie &words, bool hasDefval) {
+    _impl.setCallback(callback, context, buffer, size, hasDefval, true);
+    _impl.setTrie(words);
+}
+
 void Cli::readLine(
         StringCallback callback, uintptr_t context, char *buffer, size_t size, bool hasDefval) {
     _impl.setCallback(callback, context, buffer, size, hasDefval, false);
 }
 
+void Cli::readChunks(StringCallback callback, uintptr_t context, char *buffer, size_t size) {
+    _impl.setChunks(callback, context, buffer, size);
+}
+
 void Cli::readHex(NumberCallback callback, uintptr_t context, uint32_t limit) {
     _impl.setCallback(callback, context, 16, limit);
 }
@@ -118,6 +170,79 @@ void Cli::readNum(NumberCallback callback, uintptr_t context, uint8_t radix, uin
     _impl.setCallback(callback, context, radix, limit, defval);
 }
 
+void Cli::readHex(Number64Callback callback, uintptr_t context, uint64_t limit) {
+    _impl.setCallback(callback, context, 16, limit);
+}
+
+void Cli::readHex(Number64Callback callback, uintptr_t context, uint64_t limit, uint64_t defval) {
+    _impl.setCallback(callback, context, 16, limit, defval);
+}
+
+void Cli::readDec(Number64Callback callback, uintptr_t context, uint64_t limit) {
+    _impl.setCallback(callback, context, 10, limit);
+}
+
+void Cli::readDec(Number64Callback callback, uintptr_t context, uint64_t limit, uint64_t defval) {
+    _impl.setCallback(callback, context, 10, limit, defval);
+}
+
+void Cli::readNum(Number64Callback callback, uintptr_t context, uint8_t radix, uint64_t limit) {
+    _impl.setCallback(callback, context, radix, limit);
+}
+
+void Cli::readNum(Number64Callback callback, uintptr_t context, uint8_t radix, uint64_t limit,
+        uint64_t defval) {
+    _impl.setCallback(callback, context, radix, limit, defval);
+}
+
+void Cli::readDec(SignedCallback callback, uintptr_t context, int32_t min, int32_t max) {
+    _impl.setCallback(callback, context, 10, min, max);
+}
+
+void Cli::readDec(
+        SignedCallback callback, uintptr_t context, int32_t min, int32_t max, int32_t defval) {
+    _impl.setCallback(callback, context, 10, min, max, defval);
+}
+
+void Cli::readNum(
+        SignedCallback callback, uintptr_t context, uint8_t radix, int32_t min, int32_t max) {
+    _impl.setCallback(callback, context, radix, min, max);
+}
+
+void Cli::readNum(SignedCallback callback, uintptr_t context, uint8_t radix, int32_t min,
+        int32_t max, int32_t defval) {
+    _impl.setCallback(callback, context, radix, min, max, defval);
+}
+
+void Cli::readFixed(SignedCallback callback, uintptr_t context, uint8_t fraction, int32_t min,
+        int32_t max) {
+    _impl.setFixed(callback, context, fraction, min, max);
+}
+
+void Cli::readFixed(SignedCallback callback, uintptr_t context, uint8_t fraction, int32_t min,
+        int32_t max, int32_t defval) {
+    _impl.setFixed(callback, context, fraction, min, max, defval);
+}
+
+void Cli::readDec(Signed64Callback callback, uintptr_t context, int64_t min, int64_t max) {
+    _impl.setCallback(callback, context, 10, min, max);
+}
+
+void Cli::readDec(
+        Signed64Callback callback, uintptr_t context, int64_t min, int64_t max, int64_t defval) {
+    _impl.setCallback(callback, context, 10, min, max, defval);
+}
+
+void Cli::readNum(
+        Signed64Callback callback, uintptr_t context, uint8_t radix, int64_t min, int64_t max) {
+    _impl.setCallback(callback, context, radix, min, max);
+}
+
+void Cli::readNum(Signed64Callback callback, uintptr_t context, uint8_t radix, int64_t min,
+        int64_t max, int64_t defval) {
+    _impl.setCallback(callback, context, radix, min, max, defval);
+}
+
 }  // namespace libcli
 
 // Local Variables:
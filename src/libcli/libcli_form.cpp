@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "libcli.h"
+
+namespace libcli {
+
+void Form::begin(Cli &cli) {
+    _cli = &cli;
+    _count = 0;
+    read(false);
+}
+
+void Form::read(bool hasDefval) {
+    Field field;
+    memcpy_P(&field, &_fields[_count], sizeof(field));
+    const auto context = reinterpret_cast<uintptr_t>(this);
+    if (field.sign) {
+        const auto max = static_cast<int32_t>(field.max);
+        if (hasDefval) {
+            _cli->readNum(handleSigned, context, field.radix, field.min, max,
+                    static_cast<int32_t>(_values[_count]));
+        } else {
+            _cli->readNum(handleSigned, context, field.radix, field.min, max);
+        }
+    } else {
+        if (hasDefval) {
+            _cli->readNum(handleNumber, context, field.radix, field.max, _values[_count]);
+        } else {
+            _cli->readNum(handleNumber, context, field.radix, field.max);
+        }
+    }
+}
+
+void Form::next(uint32_t value, State state) {
+    if (state == CLI_CANCEL) {
+        _callback(*this, _context, state);
+        return;
+    }
+    if (state == CLI_DELETE) {
+        if (_count) {
+            _cli->backspace();
+            _count--;
+            read(true);
+        }
+        return;
+    }
+    _values[_count++] = value;
+    if (state == CLI_SPACE && _count < _size) {
+        read(false);
+        return;
+    }
+    for (auto i = _count; i < _size; i++)
+        _values[i] = pgm_read_dword(&_fields[i].defval);
+    _callback(*this, _context, state);
+}
+
+void Form::handleNumber(uint32_t number, uintptr_t context, State state) {
+    reinterpret_cast<Form *>(context)->next(number, state);
+}
+
+void Form::handleSigned(int32_t number, uintptr_t context, State state) {
+    reinterpret_cast<Form *>(context)->next(static_cast<uint32_t>(number), state);
+}
+
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "libcli_format.h"
+
+namespace libcli {
+namespace impl {
+
+namespace {
+
+const uint64_t POW10[] PROGMEM = {
+        1ULL,
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+        10000000000ULL,
+        100000000000ULL,
+        1000000000000ULL,
+        10000000000000ULL,
+        100000000000000ULL,
+        1000000000000000ULL,
+        10000000000000000ULL,
+        100000000000000000ULL,
+        1000000000000000000ULL,
+        10000000000000000000ULL,
+};
+
+template <typename U>
+U powerOf10(uint_fast8_t n);
+
+template <>
+uint32_t powerOf10(uint_fast8_t n) {
+    return pgm_read_dword(&POW10[n]);  // lower 32-bit of little endian
+}
+
+template <>
+uint64_t powerOf10(uint_fast8_t n) {
+    uint64_t pow;
+    memcpy_P(&pow, &POW10[n], sizeof(pow));
+    return pow;
+}
+
+/** Max number of decimal digits of type |U|. */
+template <typename U>
+constexpr uint_fast8_t maxDigits10() {
+    return sizeof(U) == sizeof(uint32_t) ? 10 : 20;
+}
+
+const char HEX_DIGITS[] PROGMEM = "0123456789ABCDEF";
+
+/** Returns bit shift for power of 2 |radix|, or 0. */
+uint_fast8_t getShift(uint_fast8_t radix) {
+    return radix == 16 ? 4 : (radix == 8 ? 3 : (radix == 2 ? 1 : 0));
+}
+
+char toDigit(uint_fast8_t n) {
+    return n < 10 ? n + '0' : n - 10 + 'A';
+}
+
+template <typename U>
+uint_fast8_t digits(U number, uint_fast8_t radix) {
+    uint_fast8_t n = 1;
+    if (radix == 10) {
+        while (n < maxDigits10<U>() && number >= powerOf10<U>(n))
+            n++;
+        return n;
+    }
+    const auto shift = getShift(radix);
+    if (shift) {
+        while (number >>= shift)
+            n++;
+        return n;
+    }
+    while (number /= radix)
+        n++;
+    return n;
+}
+
+template <typename U>
+void render(char *p, U number, uint_fast8_t radix, uint_fast8_t len) {
+    if (radix == 10) {
+#if defined(__AVR__)
+        // Division free conversion; subtract powers of 10.
+        for (auto i = len - 1; i > 0; i--) {
+            const auto pow = powerOf10<U>(i);
+            char c = '0';
+            while (number >= pow) {
+                number -= pow;
+                c++;
+            }
+            *p++ = c;
+        }
+        *p = number + '0';
+#else
+        // Division by constant is compiled into multiplication.
+        for (auto q = p + len; q > p;) {
+            *--q = number % 10 + '0';
+            number /= 10;
+        }
+#endif
+        return;
+    }
+    const auto shift = getShift(radix);
+    const uint_fast8_t mask = radix - 1;
+    for (auto q = p + len; q > p;) {
+        if (shift) {
+            *--q = toDigit(number & mask);
+            number >>= shift;
+        } else {
+            *--q = toDigit(number % radix);
+            number /= radix;
+        }
+    }
+}
+
+}  // namespace
+
+uint_fast8_t getDigits(uint32_t number, uint_fast8_t radix) {
+    return digits(number, radix);
+}
+
+uint_fast8_t getDigits(uint64_t number, uint_fast8_t radix) {
+    if (number <= UINT32_MAX)
+        return digits(static_cast<uint32_t>(number), radix);
+    return digits(number, radix);
+}
+
+void Formatter::send() {
+    if (_len) {
+        _total += _out.write(reinterpret_cast<const uint8_t *>(_buffer), _len);
+        _len = 0;
+    }
+}
+
+char *Formatter::reserve(uint_fast8_t n) {
+    if (_len + n > _size)
+        send();
+    auto p = _buffer + _len;
+    _len += n;
+    return p;
+}
+
+Formatter &Formatter::fill(char c, int_fast8_t n) {
+    while (n > 0) {
+        if (_len == _size)
+            send();
+        const auto room = _size - _len;
+        const auto chunk = static_cast<size_t>(n) < room ? n : room;
+        memset(_buffer + _len, c, chunk);
+        _len += chunk;
+        n -= chunk;
+    }
+    return *this;
+}
+
+Formatter &Formatter::put(const char *text, size_t len) {
+    while (len) {
+        if (_len == _size)
+            send();
+        const auto room = _size - _len;
+        const auto chunk = len < room ? len : room;
+        memcpy(_buffer + _len, text, chunk);
+        _len += chunk;
+        text += chunk;
+        len -= chunk;
+    }
+    return *this;
+}
+
+Formatter &Formatter::put_P(const /*PROGMEM*/ char *text_P, size_t len) {
+    while (len) {
+        if (_len == _size)
+            send();
+        const auto room = _size - _len;
+        const auto chunk = len < room ? len : room;
+        memcpy_P(_buffer + _len, text_P, chunk);
+        _len += chunk;
+        text_P += chunk;
+        len -= chunk;
+    }
+    return *this;
+}
+
+Formatter &Formatter::fixed(
+        uint32_t number, uint_fast8_t fraction, int_fast8_t width, bool negative) {
+    char text[FIXED_FRACTION_MAX];
+    if (fraction > FIXED_FRACTION_MAX)
+        fraction = FIXED_FRACTION_MAX;
+    for (auto i = fraction; i;) {
+        text[--i] = number % 10 + '0';
+        number /= 10;
+    }
+    const int_fast8_t len = digits(number, 10) + (negative ? 1 : 0) + (fraction ? fraction + 1 : 0);
+    fill(' ', width - len);
+    if (negative)
+        put('-');
+    format(number, 10, 0, false);
+    if (fraction)
+        put('.').put(text, fraction);
+    fill(' ', -width - len);
+    return *this;
+}
+
+Formatter &Formatter::hex(uint32_t number, uint_fast8_t digits) {
+    for (auto p = reserve(digits) + digits; digits; digits--) {
+        *--p = pgm_read_byte(&HEX_DIGITS[number & 0xF]);
+        number >>= 4;
+    }
+    return *this;
+}
+
+template <typename U>
+Formatter &Formatter::format(U number, uint_fast8_t radix, int_fast8_t width, bool negative) {
+    const int_fast8_t len = digits(number, radix) + (negative ? 1 : 0);
+    if (radix == 10)
+        fill(' ', width - len);
+    if (negative)
+        put('-');
+    if (radix != 10)
+        fill('0', width - len);
+    render(reserve(len - negative), number, radix, len - negative);
+    fill(' ', -width - len);
+    return *this;
+}
+
+Formatter &Formatter::number(
+        uint32_t number, uint_fast8_t radix, int_fast8_t width, bool negative) {
+    return format(number, radix, width, negative);
+}
+
+Formatter &Formatter::number(
+        uint64_t number, uint_fast8_t radix, int_fast8_t width, bool negative) {
+    if (number <= UINT32_MAX)
+        return format(static_cast<uint32_t>(number), radix, width, negative);
+    return format(number, radix, width, negative);
+}
+
+}  // namespace impl
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
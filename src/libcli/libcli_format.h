@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_FORMAT_H__
+#define __LIBCLI_FORMAT_H__
+
+#include <Arduino.h>
+
+#include "libcli_types.h"
+
+namespace libcli {
+namespace impl {
+
+/** Returns number of digits of |number| in |radix|. */
+uint_fast8_t getDigits(uint32_t number, uint_fast8_t radix);
+uint_fast8_t getDigits(uint64_t number, uint_fast8_t radix);
+
+/**
+ * Format text and numbers into |buffer| and send it to |out| with a single write. When
+ * |buffer| gets full, the buffered text is sent and formatting continues.
+ */
+struct Formatter final {
+    Formatter(Print &out, char *buffer, size_t size)
+        : _out(out), _buffer(buffer), _size(size), _len(0), _total(0) {}
+
+    /** Append |c|. */
+    Formatter &put(char c) {
+        if (_len == _size)
+            send();
+        _buffer[_len++] = c;
+        return *this;
+    }
+    /** Append |c| |n| times. */
+    Formatter &fill(char c, int_fast8_t n);
+    /** Append |len| chars of |text|. */
+    Formatter &put(const char *text, size_t len);
+    /** Append |len| chars of |text_P| in program memory. */
+    Formatter &put_P(const /*PROGMEM*/ char *text_P, size_t len);
+    /**
+     * Append |number| in |radix| aligned in |width| chars. Negative |width| means left aligned.
+     * Right aligned hexadecimal, octal and binary are 0-prefixed. |negative| prepends '-' sign.
+     */
+    Formatter &number(
+            uint32_t number, uint_fast8_t radix, int_fast8_t width = 0, bool negative = false);
+    Formatter &number(
+            uint64_t number, uint_fast8_t radix, int_fast8_t width = 0, bool negative = false);
+    /**
+     * Append fixed-point |number| scaled by 10^|fraction| as decimal with |fraction| digits
+     * after point, aligned in |width| chars.
+     */
+    Formatter &fixed(uint32_t number, uint_fast8_t fraction, int_fast8_t width = 0,
+            bool negative = false);
+    /** Append |digits| hexadecimal digits of |number|, which must fit in |buffer|. */
+    Formatter &hex(uint32_t number, uint_fast8_t digits);
+    /** Append newline. */
+    Formatter &newline() { return put('\r').put('\n'); }
+
+    /** Send the formatted text, and returns the total number of chars sent. */
+    size_t flush() {
+        send();
+        return _total;
+    }
+
+private:
+    Print &_out;
+    char *const _buffer;
+    const size_t _size;
+    size_t _len;
+    size_t _total;
+
+    void send();
+    /** Returns room of |n| chars, which must not exceed the buffer size. */
+    char *reserve(uint_fast8_t n);
+    template <typename U>
+    Formatter &format(U number, uint_fast8_t radix, int_fast8_t width, bool negative);
+};
+
+}  // namespace impl
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "libcli_frame.h"
+
+namespace libcli {
+
+namespace {
+
+/** CRC-16/CCITT-FALSE (polynomial 0x1021) of a nibble. */
+const uint16_t CRC_TABLE[16] PROGMEM = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,  //
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,  //
+};
+
+}  // namespace
+
+uint16_t Frame::crc16(uint16_t crc, uint8_t data) {
+    crc = (crc << 4) ^ pgm_read_word(&CRC_TABLE[(crc >> 12) ^ (data >> 4)]);
+    crc = (crc << 4) ^ pgm_read_word(&CRC_TABLE[(crc >> 12) ^ (data & 0xF)]);
+    return crc;
+}
+
+bool Framer::accept(uint8_t c) {
+    const uint16_t now = millis();
+    if (_pos && uint16_t(now - _last) > TIMEOUT_MS) {
+        _pos = 0;  // abandoned frame
+        _errors++;
+    }
+    if (_pos == 0) {
+        if (c != Frame::STX)
+            return false;
+        _crc = Frame::CRC_INIT;
+    } else {
+        _crc = Frame::crc16(_crc, c);
+        if (_pos == 1) {
+            _frameSize = c;
+        } else if (_pos == 2) {
+            _id = c;
+        } else if (_pos < _frameSize + 3U) {
+            if (_pos - 3U < _size)
+                _buffer[_pos - 3] = c;
+        } else if (_pos == _frameSize + 4U) {
+            _pos = 0;
+            if (_crc == 0 && _frameSize <= _size) {
+                dispatch();
+            } else {
+                _errors++;
+            }
+            return true;
+        }
+    }
+    _pos++;
+    _last = now;
+    return true;
+}
+
+void Framer::dispatch() {
+    for (size_t i = 0; i < _count; i++) {
+        const auto &cmd = _commands[i];
+        if (pgm_read_byte(&cmd.id) != _id)
+            continue;
+        const auto size = pgm_read_byte(&cmd.size);
+        if (size != FrameCommand::ANY_SIZE && size != _frameSize)
+            break;
+        const auto handler = reinterpret_cast<FrameHandler>(pgm_read_ptr(&cmd.handler));
+        const Frame frame{_id, _frameSize, _buffer};
+        handler(frame, _context);
+        return;
+    }
+    _errors++;  // unknown id or unexpected size
+}
+
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
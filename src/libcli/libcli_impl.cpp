@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "libcli_impl.h"
+#include "libcli_format.h"
 
 namespace libcli {
 namespace impl {
@@ -35,78 +36,459 @@ bool isNewline(char c) {
     return c == '\n' || c == '\r';
 }
 
-/** Returns number of digits of |number| in |radix|. */
-int_fast8_t getDigits(uint32_t number, uint_fast8_t radix) {
-    int_fast8_t n = 0;
-    do {
-        n++;
-        number /= radix;
-    } while (number);
-    return n;
+/** Cursor keys decoded from escape sequences in ANSI mode, which are those of readline. */
+constexpr char KEY_HOME = '\x01';
+constexpr char KEY_LEFT = '\x02';
+constexpr char KEY_END = '\x05';
+constexpr char KEY_RIGHT = '\x06';
+
+/** Returns absolute value of |value| as unsigned |U|. */
+template <typename U, typename S>
+U magnitude(S value) {
+    return value < 0 ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+}
+
+/** Returns the limit of positive magnitude up to |max|, which is 0 if |max| is negative. */
+template <typename U, typename S>
+U limitOf(S max) {
+    return max < 0 ? 0 : static_cast<U>(max);
+}
+
+/** Returns the limit of negative magnitude down to |min|, which is 0 if |min| is positive. */
+template <typename U, typename S>
+U negLimitOf(S min) {
+    return min > 0 ? 0 : magnitude<U>(min);
+}
+
+/** Returns the least magnitude between |min| and |max|, which is not 0 if 0 is out of range. */
+template <typename U, typename S>
+U lowOf(S min, S max) {
+    return min > 0 ? static_cast<U>(min) : (max < 0 ? magnitude<U>(max) : 0);
+}
+
+/** Buffer size to format a binary number of |bytes| with sign, some padding and newline. */
+constexpr size_t numBufferSize(size_t bytes) {
+    return bytes * 8 + 8;
 }
+constexpr size_t NUM_BUFFER_SIZE = numBufferSize(sizeof(uint32_t));
+
+/** Buffer size to format a string with padding. */
+constexpr size_t STR_BUFFER_SIZE = 32;
+/** Buffer for printFormat, which must hold 32 binary digits. */
+constexpr size_t FORMAT_BUFFER_SIZE = 64;
+
+/** Bytes in a row of dump. */
+constexpr uint_fast8_t DUMP_ROW = 16;
+
+/** Buffer size to format a row of dump; address, bytes with group separators and text. */
+constexpr size_t DUMP_BUFFER_SIZE = 8 + 1 + DUMP_ROW * 3 + DUMP_ROW + 2 + DUMP_ROW + 2;
 
 }  // namespace
 
-size_t Impl::pad_left(int_fast8_t len, int_fast8_t width, char pad) {
-    size_t size = 0;
-    for (auto n = width - len; n > 0; n--)
-        size += console->print(pad);
-    return size;
+size_t Impl::loop(size_t maxBytes, uint32_t budget) {
+    woken = false;
+    const auto start = budget ? micros() : stamp();
+    const auto current = processor;
+    size_t n = 0;
+    // Defer input while non-blocking output is congested.
+    while (!output.busy() && available()) {
+        countIn();
+        process(read());
+        if (++n == maxBytes || processor != current)
+            break;
+        if (budget && micros() - start >= budget)
+            break;
+    }
+    if (n)
+        countLoop(start);
+    output.drain();
+    settle(n ? CLI_CONSUMED : CLI_IDLE);
+    return n;
+}
+
+LoopStatus Impl::settle(uint_fast8_t status) {
+    if (available() || output.pending())
+        status |= CLI_PENDING;
+    if (status == CLI_IDLE && idle)
+        idle(idle_context);
+    return static_cast<LoopStatus>(status);
+}
+
+void Impl::setScript(const char *text, bool progmem) {
+    script = text;
+    script_P = progmem;
+    if (script && peekScript() == 0)
+        script = nullptr;
+    echo.muted = script != nullptr;
+}
+
+void Impl::setFramer(Framer *framer) {
+    this->framer = framer;
+    filter = framer ? &Impl::acceptFrame : nullptr;
 }
 
-size_t Impl::pad_right(int_fast8_t len, int_fast8_t width, char pad) {
-    size_t size = 0;
-    for (auto n = width + len; n < 0; n++)
-        size += console->print(pad);
-    return size;
+bool Impl::acceptFrame(char c) {
+    return framer->accept(c);
+}
+
+int Impl::readScript() {
+    const auto c = peekScript();
+    script++;
+    if (peekScript() == 0)
+        script = nullptr;
+    return static_cast<uint8_t>(c);
 }
 
 size_t Impl::printNum(uint32_t number, int_fast8_t width, uint_fast8_t radix, bool newline) {
-    const auto len = getDigits(number, radix);
-    auto size = pad_left(len, width, radix == 10 ? ' ' : '0');
-    size += console->print(number, radix);
-    size += pad_right(len, width, ' ');
+    char buffer[NUM_BUFFER_SIZE];
+    Formatter fmt(output, buffer, sizeof(buffer));
+    fmt.number(number, radix, width);
+    if (newline)
+        fmt.newline();
+    return fmt.flush();
+}
+
+size_t Impl::printFixed(int32_t number, uint_fast8_t fraction, int_fast8_t width, bool newline) {
+    char buffer[NUM_BUFFER_SIZE];
+    Formatter fmt(output, buffer, sizeof(buffer));
+    fmt.fixed(magnitude<uint32_t>(number), fraction, width, number < 0);
     if (newline)
-        size += console->println();
-    return size;
+        fmt.newline();
+    return fmt.flush();
 }
 
 size_t Impl::printStr(const __FlashStringHelper *text, int_fast8_t width, bool newline) {
-    const auto l = strlen_P(reinterpret_cast<const char *>(text));
-    const auto len = (l < INT8_MAX) ? l : INT8_MAX;
-    auto size = pad_left(len, width, ' ');
-    size += console->print(text);
-    size += pad_right(len, width, ' ');
+    const auto text_P = reinterpret_cast<const char *>(text);
+    return printStr_P(text_P, strlen_P(text_P), width, newline);
+}
+
+size_t Impl::printStr(const Str &str, int_fast8_t width, bool newline) {
+    return printStr_P(str.text_P(), str.length(), width, newline);
+}
+
+size_t Impl::printStr_P(const char *text_P, size_t l, int_fast8_t width, bool newline) {
+    const int_fast8_t len = (l < INT8_MAX) ? l : INT8_MAX;
+    char buffer[STR_BUFFER_SIZE];
+    Formatter fmt(output, buffer, sizeof(buffer));
+    fmt.fill(' ', width - len).put_P(text_P, l).fill(' ', -width - len);
     if (newline)
-        size += console->println();
-    return size;
+        fmt.newline();
+    return fmt.flush();
+}
+
+size_t Impl::printFormat(const /*PROGMEM*/ char *program, const format::Arg *args) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    Formatter fmt(output, buffer, sizeof(buffer));
+    for (auto p = program;;) {
+        const char c = pgm_read_byte(p++);
+        if (c == 0)
+            break;
+        if (static_cast<uint8_t>(c) >= format::OP_END) {
+            if (c == '\n') {
+                fmt.newline();
+            } else {
+                fmt.put(c);
+            }
+            continue;
+        }
+        const uint_fast8_t skip = pgm_read_byte(p++);
+        const int_fast8_t width = skip > 1 ? static_cast<int8_t>(pgm_read_byte(p)) : 0;
+        p += skip - 1;
+        if (c == format::OP_PERCENT) {
+            fmt.put('%');
+            continue;
+        }
+        const auto &arg = *args++;
+        if (c == format::OP_STR && arg.type >= format::Arg::STR) {
+            const auto l = arg.type == format::Arg::STR ? strlen(arg.str) : strlen_P(arg.str);
+            const int_fast8_t len = (l < INT8_MAX) ? l : INT8_MAX;
+            fmt.fill(' ', width - len);
+            if (arg.type == format::Arg::STR) {
+                fmt.put(arg.str, l);
+            } else {
+                fmt.put_P(arg.str, l);
+            }
+            fmt.fill(' ', -width - len);
+        } else if (c == format::OP_CHAR) {
+            fmt.fill(' ', width - 1).put(static_cast<char>(arg.u)).fill(' ', -width - 1);
+        } else if (c == format::OP_HEX || c == format::OP_OCT || c == format::OP_BIN) {
+            const uint_fast8_t radix = c == format::OP_HEX ? 16 : (c == format::OP_OCT ? 8 : 2);
+            fmt.number(arg.u, radix, width);
+        } else if (arg.type == format::Arg::SIGNED && arg.s < 0 && c != format::OP_UDEC) {
+            fmt.number(uint32_t(0) - arg.u, 10, width, true);
+        } else {
+            fmt.number(arg.u, 10, width);
+        }
+    }
+    return fmt.flush();
 }
 
 size_t Impl::printStr(const char *text, int_fast8_t width, bool newline) {
     const auto l = strlen(text);
-    const auto len = (l < INT8_MAX) ? l : INT8_MAX;
-    auto size = pad_left(len, width, ' ');
-    size += console->print(text);
-    size += pad_right(len, width, ' ');
+    const int_fast8_t len = (l < INT8_MAX) ? l : INT8_MAX;
+    char buffer[STR_BUFFER_SIZE];
+    Formatter fmt(output, buffer, sizeof(buffer));
+    fmt.fill(' ', width - len).put(text, l).fill(' ', -width - len);
     if (newline)
-        size += console->println();
-    return size;
+        fmt.newline();
+    return fmt.flush();
+}
+
+size_t Impl::sendFrame(uint8_t id, const uint8_t *data, uint8_t size) {
+    uint8_t header[] = {Frame::STX, size, id};
+    auto crc = Frame::crc16(Frame::crc16(Frame::CRC_INIT, size), id);
+    for (uint8_t i = 0; i < size; i++)
+        crc = Frame::crc16(crc, data[i]);
+    const uint8_t trailer[] = {uint8_t(crc >> 8), uint8_t(crc)};
+    auto n = output.write(header, sizeof(header));
+    if (size)
+        n += output.write(data, size);
+    n += output.write(trailer, sizeof(trailer));
+    return n;
+}
+
+size_t Impl::printDump(uint32_t address, size_t len, const uint8_t *data, DumpReader reader,
+        uintptr_t context, int_fast8_t addrWidth, uint_fast8_t group, bool ascii) {
+    if (addrWidth > 8)
+        addrWidth = 8;
+    size_t total = 0;
+    size_t index = 0;
+    uint_fast8_t lead = address % DUMP_ROW;
+    char buffer[DUMP_BUFFER_SIZE];
+    for (auto base = address - lead; index < len; base += DUMP_ROW, lead = 0) {
+        char text[DUMP_ROW];
+        Formatter fmt(output, buffer, sizeof(buffer));
+        if (addrWidth > 0)
+            fmt.hex(base, addrWidth).put(':');
+        for (uint_fast8_t i = 0; i < DUMP_ROW; i++) {
+            if (index >= len && !ascii)
+                break;
+            if (group && i && i % group == 0)
+                fmt.put(' ');
+            if (i < lead || index >= len) {
+                fmt.fill(' ', 3);
+                text[i] = ' ';
+                continue;
+            }
+            const uint8_t b = data ? data[index] : reader(address + index, context);
+            index++;
+            fmt.put(' ').hex(b, 2);
+            text[i] = isPrintable(b) ? b : '.';
+        }
+        if (ascii)
+            fmt.fill(' ', 2).put(text, DUMP_ROW);
+        total += fmt.newline().flush();
+    }
+    return total;
 }
 
 size_t Impl::backspace(int_fast8_t n) {
+    if (ansi && n > 2)
+        return (this->*ansi->erase)(n);
+    size_t s = 0;
+    while (n--)
+        s += echo.print(F("\b \b"));
+    return s;
+}
+
+void Impl::setAnsi(bool enable) {
+    // Referred only from here so that line editing is linked only when it is used.
+    static const Terminal ANSI = {&Impl::escape, &Impl::editString, &Impl::eraseLeft};
+    ansi = enable ? &ANSI : nullptr;
+    esc = ESC_NONE;
+}
+
+/** Erasing to end of line costs the same for any |n|. */
+size_t Impl::eraseLeft(int_fast8_t n) {
+    return cursorLeft(n) + echo.print(F("\x1b[K"));
+}
+
+size_t Impl::cursorLeft(size_t n) {
+    if (n > 3)
+        return echo.print(F("\x1b[")) + echo.print(n) + echo.print('D');
     size_t s = 0;
     while (n--)
-        s += console->print(F("\b \b"));
+        s += echo.print('\b');
     return s;
 }
 
+bool Impl::escape(char &c) {
+    if (esc == ESC_NONE) {
+        if (c != '\x1b')
+            return true;
+        esc = ESC_START;
+        return false;
+    }
+    if (esc == ESC_START) {
+        if (c == '[' || c == 'O') {
+            esc = ESC_CSI;
+            esc_param = 0;
+            return false;
+        }
+        esc = ESC_NONE;
+        return true;  // a lone escape is ignored
+    }
+    if (c >= '0' && c <= '?') {  // parameter bytes
+        esc_param = isDigit(c) ? esc_param * 10 + (c - '0') : 0;
+        return false;
+    }
+    esc = ESC_NONE;
+    if (c == 'D') {
+        c = KEY_LEFT;
+    } else if (c == 'C') {
+        c = KEY_RIGHT;
+    } else if (c == 'H' || (c == '~' && (esc_param == 1 || esc_param == 7))) {
+        c = KEY_HOME;
+    } else if (c == 'F' || (c == '~' && (esc_param == 4 || esc_param == 8))) {
+        c = KEY_END;
+    } else {
+        return false;
+    }
+    // Only string input has a cursor to move.
+    return processor == &Impl::processString;
+}
+
 void Impl::setCallback(LetterCallback callback, uintptr_t context) {
     this->callback.letter = callback;
     setProcessor(&Impl::processLetter, context);
 }
 
 void Impl::processLetter(char c) {
+    const auto start = stamp();
     callback.letter(c, context);
+    countLetter(start);
+}
+
+void Impl::setCallback(const CommandTable *commands, uintptr_t context) {
+    this->callback.commands = commands;
+    setProcessor(&Impl::processCommand, context);
+}
+
+void Impl::processCommand(char c) {
+    const char name[] = {c, 0};
+    dispatch(name, CLI_SPACE);
+}
+
+void Impl::setCallback(
+        const CommandTable *commands, uintptr_t context, char *buffer, size_t size) {
+    setCallback(StringCallback(nullptr), context, buffer, size, false, true);
+    this->callback.commands = commands;
+    str_command = &Impl::doneCommand;
+}
+
+void Impl::setLoader(Loader &loader) {
+    loader.reset();
+    this->callback.loader = &loader;
+    setProcessor(&Impl::processLoad, 0);
+}
+
+bool Impl::dispatch(const char *name, State state) {
+    const auto table = callback.commands;
+    const auto commands = static_cast<const Command *>(pgm_read_ptr(&table->commands));
+    uint_fast8_t index = pgm_read_byte(&table->fallback);
+    if (state == CLI_SPACE || state == CLI_NEWLINE) {
+        uint8_t hash = pgm_read_byte(&table->seed);
+        for (auto p = name; *p; p++)
+            hash = command::hashStep(hash, *p);
+        const auto slots = static_cast<const uint8_t *>(pgm_read_ptr(&table->slots));
+        const auto i = pgm_read_byte(&slots[hash >> pgm_read_byte(&table->shift)]);
+        if (i != command::NONE && strncmp_P(name, commands[i].name, sizeof(Command::name)) == 0)
+            index = i;
+    }
+    if (index == command::NONE)
+        return false;
+    const auto handler =
+            reinterpret_cast<CommandHandler>(pgm_read_ptr(&commands[index].handler));
+    const auto start = stamp();
+    handler(name, context, state);
+    countCallback(start, state);
+    return true;
+}
+
+void Impl::doneString(State state) {
+    if (str_command) {
+        (this->*str_command)(state);
+        return;
+    }
+    const auto start = stamp();
+    callback.string(str_buffer, context, state);
+    countCallback(start, state);
+}
+
+void Impl::doneCommand(State state) {
+    const auto buffer = str_buffer;
+    if (!dispatch(buffer, state) && reading(buffer) && str_command) {
+        // Unknown command; erase it and read again.
+        if (state == CLI_SPACE || state == CLI_NEWLINE)
+            backspace(str_len + 1);
+        str_buffer[str_len = 0] = 0;
+    }
+}
+
+uint_fast8_t Impl::childOf(const TrieNode *nodes, uint_fast8_t node) const {
+    const uint_fast8_t next = node + 1;
+    if (next >= pgm_read_byte(&trie->size))
+        return trie::NONE;
+    const auto depth = pgm_read_byte(&nodes[node].depth) & TrieNode::DEPTH;
+    const auto next_depth = pgm_read_byte(&nodes[next].depth) & TrieNode::DEPTH;
+    return next_depth == depth + 1 ? next : trie::NONE;
+}
+
+void Impl::complete() {
+    const auto nodes = static_cast<const TrieNode *>(pgm_read_ptr(&trie->nodes));
+    // Follow the input from the root; each letter costs a walk over siblings at its depth.
+    uint_fast8_t node = trie::NONE;
+    uint_fast8_t child = 0;
+    for (size_t i = 0; i < str_len; i++) {
+        while (child != trie::NONE && pgm_read_byte(&nodes[child].letter) != str_buffer[i])
+            child = pgm_read_byte(&nodes[child].sibling);
+        if (child == trie::NONE) {
+            countDropped();  // no word starts with the input.
+            return;
+        }
+        node = child;
+        child = childOf(nodes, node);
+    }
+    // Extend the input while there is only one choice.
+    const auto len = str_len;
+    while (child != trie::NONE && str_len < str_limit &&
+            (node == trie::NONE || !(pgm_read_byte(&nodes[node].depth) & TrieNode::TERMINAL)) &&
+            pgm_read_byte(&nodes[child].sibling) == trie::NONE) {
+        const char c = pgm_read_byte(&nodes[child].letter);
+        str_buffer[str_len++] = c;
+        str_buffer[str_len] = 0;
+        echo.print(c);
+        node = child;
+        child = childOf(nodes, node);
+    }
+    if (str_len == len && child != trie::NONE)
+        listWords(nodes, node, child);
+}
+
+void Impl::listWords(const TrieNode *nodes, uint_fast8_t node, uint_fast8_t child) {
+    echo.println();
+    if (node != trie::NONE && (pgm_read_byte(&nodes[node].depth) & TrieNode::TERMINAL)) {
+        echo.write(str_buffer, str_len);
+        echo.print(' ');
+    }
+    // Nodes are in preorder; the subtree ends at a node which is not deeper than the input.
+    const uint_fast8_t size = pgm_read_byte(&trie->size);
+    for (auto i = child; i < size; i++) {
+        const auto depth = pgm_read_byte(&nodes[i].depth);
+        const size_t d = depth & TrieNode::DEPTH;
+        if (d < str_len)
+            break;
+        if (d >= str_limit)
+            continue;  // longer than buffer.
+        str_buffer[d] = pgm_read_byte(&nodes[i].letter);
+        if (depth & TrieNode::TERMINAL) {
+            echo.write(str_buffer, d + 1);
+            echo.print(' ');
+        }
+    }
+    str_buffer[str_len] = 0;
+    echo.println();
+    echo.write(str_buffer, str_len);
 }
 
 void Impl::setCallback(StringCallback callback, uintptr_t context, char *buffer, size_t size,
@@ -119,108 +501,453 @@ void Impl::setCallback(StringCallback callback, uintptr_t context, char *buffer,
     } else {
         str_buffer[str_len = 0] = 0;
     }
+    str_pos = str_len;
     str_word = word;
+    str_command = nullptr;
+    str_chunk = false;
+    trie = nullptr;
+    completer = nullptr;
     setProcessor(&Impl::processString, context);
 }
 
+void Impl::setTrie(const Trie &words) {
+    trie = &words;
+    completer = &Impl::complete;
+}
+
+void Impl::setChunks(StringCallback callback, uintptr_t context, char *buffer, size_t size) {
+    setCallback(callback, context, buffer, size, false, false);
+    str_chunk = true;
+}
+
+void Impl::endOfString() {
+    echo.write(str_buffer + str_pos, str_len - str_pos);
+    str_pos = str_len;
+}
+
+/** Redraw |str_buffer| after the cursor, and erase a column left by deletion if |erase|. */
+void Impl::redrawString(bool erase) {
+    echo.write(str_buffer + str_pos, str_len - str_pos);
+    if (erase)
+        echo.print(F("\x1b[K"));
+    cursorLeft(str_len - str_pos);
+}
+
+bool Impl::editString(char c) {
+    if (c == KEY_LEFT) {
+        if (str_pos) {
+            str_pos--;
+            echo.print('\b');
+        }
+    } else if (c == KEY_RIGHT) {
+        if (str_pos < str_len)
+            echo.print(str_buffer[str_pos++]);
+    } else if (c == KEY_HOME) {
+        cursorLeft(str_pos);
+        str_pos = 0;
+    } else if (c == KEY_END) {
+        endOfString();
+    } else if (str_pos == str_len) {
+        return false;
+    } else if (isNewline(c) || isCancel(c) || (str_word && isSpace(c))) {
+        endOfString();
+        return false;
+    } else if (isBackspace(c)) {
+        if (str_pos) {
+            memmove(str_buffer + str_pos - 1, str_buffer + str_pos, str_len - str_pos + 1);
+            str_pos--;
+            str_len--;
+            echo.print('\b');
+            redrawString(true);
+        }
+    } else if (str_len < str_limit) {
+        memmove(str_buffer + str_pos + 1, str_buffer + str_pos, str_len - str_pos + 1);
+        str_buffer[str_pos] = c;
+        str_len++;
+        echo.print(str_buffer[str_pos++]);
+        redrawString(false);
+    } else {
+        countDropped();
+    }
+    return true;
+}
+
 void Impl::processString(char c) {
+    // A chunk which is called back can't be edited.
+    if (ansi && !str_chunk && (this->*ansi->edit)(c))
+        return;
     if (isNewline(c)) {
-        console->print(' ');
-        callback.string(str_buffer, context, CLI_NEWLINE);
+        echo.print(' ');
+        doneString(CLI_NEWLINE);
+    } else if (c == '\t' && str_word && completer) {
+        (this->*completer)();
     } else if (isSpace(c) && str_word) {
         if (str_len) {  // can't accept leading spaces in word
-            console->print(c);
-            callback.string(str_buffer, context, CLI_SPACE);
+            echo.print(c);
+            doneString(CLI_SPACE);
         }
     } else if (isBackspace(c)) {
         if (str_len) {
             str_buffer[--str_len] = 0;
             backspace(1);
         } else if (str_word) {
-            callback.string(str_buffer, context, CLI_DELETE);
+            doneString(CLI_DELETE);
         }
     } else if (isCancel(c)) {
-        console->println(F(" cancel"));
-        callback.string(str_buffer, context, CLI_CANCEL);
+        echo.println(F(" cancel"));
+        doneString(CLI_CANCEL);
     } else if (str_len < str_limit) {
         str_buffer[str_len++] = c;
         str_buffer[str_len] = 0;
-        console->print(c);
+        echo.print(c);
+        if (str_chunk && str_len == str_limit) {
+            const auto buffer = str_buffer;
+            doneString(CLI_CONTINUE);
+            if (reading(buffer) && str_chunk)
+                str_buffer[str_len = 0] = 0;
+        }
+    } else {
+        countDropped();
+    }
+    str_pos = str_len;
+}
+
+template <typename U>
+void Impl::setNumber(uintptr_t context, uint_fast8_t radix, U limit, U neg_limit, bool sign) {
+    auto &num = number(U());
+    // Divide limits beforehand, so that processing a digit needs no division.
+    num.quot = limit / radix;
+    num.rem = limit % radix;
+    num.neg_quot = neg_limit / radix;
+    num.neg_rem = neg_limit % radix;
+    num.low = 0;
+    num.value = 0;
+    const auto width = getDigits(limit, radix);
+    const auto neg_width = getDigits(neg_limit, radix);
+    num_width = width < neg_width ? neg_width : width;
+    num_radix = radix;
+    num_len = 0;
+    num_signed = sign;
+    num_negative = false;
+    if (radix == 16) {
+        setProcessor(&Impl::processNumber<U, 16>, context);
+    } else if (radix == 10) {
+        setProcessor(&Impl::processNumber<U, 10>, context);
+    } else {
+        setProcessor(&Impl::processNumber<U, 0>, context);
+    }
+}
+
+template <typename U>
+void Impl::setDefault(U value, bool negative) {
+    number(U()).value = value;
+    if (num_signed) {
+        backspace(num_width + 1);
+        num_negative = negative;
+        num_len = getDigits(value, num_radix);
+        printNumber(value, 0, num_radix, negative);
+    } else {
+        backspace(num_width);
+        num_len = num_width;
+        printNumber(value, num_len, num_radix, false);
     }
 }
 
 void Impl::setCallback(
         NumberCallback callback, uintptr_t context, uint_fast8_t radix, uint32_t limit) {
     this->callback.number = callback;
-    num_width = getDigits(num_limit = limit, num_radix = radix);
-    num_value = 0;
-    num_len = 0;
-    setProcessor(&Impl::processNumber, context);
+    setNumber<uint32_t>(context, radix, limit, 0, false);
 }
 
 void Impl::setCallback(NumberCallback callback, uintptr_t context, uint_fast8_t radix,
         uint32_t limit, uint32_t defval) {
     setCallback(callback, context, radix, limit);
-    backspace(num_width);
-    num_value = defval;
-    num_len = num_width;
-    printNum(num_value, num_len, radix, false);
+    setDefault(defval, false);
 }
 
-bool Impl::checkLimit(char c, uint_fast8_t &n) const {
-    if (num_len >= num_width)
-        return false;
-    c = toUpperCase(c);
-    if (num_radix <= 10 && c >= '0' && c < num_radix + '0') {
-        n = c - '0';
-        const auto limit = num_limit / num_radix;
-        return num_value < limit || (num_value == limit && n <= (num_limit % num_radix));
+void Impl::setCallback(
+        Number64Callback callback, uintptr_t context, uint_fast8_t radix, uint64_t limit) {
+    this->callback.number64 = callback;
+    setNumber<uint64_t>(context, radix, limit, 0, false);
+}
+
+void Impl::setCallback(Number64Callback callback, uintptr_t context, uint_fast8_t radix,
+        uint64_t limit, uint64_t defval) {
+    setCallback(callback, context, radix, limit);
+    setDefault(defval, false);
+}
+
+void Impl::setCallback(SignedCallback callback, uintptr_t context, uint_fast8_t radix,
+        int32_t min, int32_t max) {
+    this->callback.signed32 = callback;
+    setNumber<uint32_t>(
+            context, radix, limitOf<uint32_t>(max), negLimitOf<uint32_t>(min), true);
+    num32.low = lowOf<uint32_t>(min, max);
+}
+
+void Impl::setCallback(SignedCallback callback, uintptr_t context, uint_fast8_t radix,
+        int32_t min, int32_t max, int32_t defval) {
+    setCallback(callback, context, radix, min, max);
+    setDefault(magnitude<uint32_t>(defval), defval < 0);
+}
+
+void Impl::setFixed(SignedCallback callback, uintptr_t context, uint_fast8_t fraction,
+        int32_t min, int32_t max) {
+    if (fraction > FIXED_FRACTION_MAX)
+        fraction = FIXED_FRACTION_MAX;
+    this->callback.signed32 = callback;
+    fixed.limit = limitOf<uint32_t>(max);
+    fixed.neg_limit = negLimitOf<uint32_t>(min);
+    fixed.num.low = lowOf<uint32_t>(min, max);
+    fixed.num.value = 0;
+    auto integer = fixed.limit < fixed.neg_limit ? fixed.neg_limit : fixed.limit;
+    for (auto i = fraction; i; i--)
+        integer /= 10;
+    num_width = getDigits(integer, 10) + (fraction ? fraction + 1 : 0);
+    num_radix = 10;
+    num_len = 0;
+    num_signed = true;
+    num_negative = false;
+    fix_digits = fraction;
+    fix_fraction = 0;
+    fix_point = false;
+    setFixedLimit();
+    setProcessor(&Impl::processFixed, context);
+}
+
+void Impl::setFixed(SignedCallback callback, uintptr_t context, uint_fast8_t fraction,
+        int32_t min, int32_t max, int32_t defval) {
+    setFixed(callback, context, fraction, min, max);
+    backspace(num_width + 1);
+    fixed.num.value = magnitude<uint32_t>(defval);
+    num_negative = defval < 0;
+    fix_fraction = fix_digits;
+    fix_point = fix_digits != 0;
+    num_len = echoFixed(0) - num_negative;
+    setFixedLimit();
+}
+
+size_t Impl::echoFixed(int_fast8_t width) {
+    char buffer[NUM_BUFFER_SIZE];
+    Formatter fmt(echo, buffer, sizeof(buffer));
+    fmt.fixed(fixed.num.value, fix_digits, width, num_negative);
+    return fmt.flush();
+}
+
+void Impl::setFixedLimit() {
+    // A next digit must keep the value scaled by the rest of fraction digits within limits.
+    auto &num = fixed.num;
+    auto limit = fixed.limit;
+    auto neg_limit = fixed.neg_limit;
+    for (auto i = fix_point ? fix_digits - fix_fraction - 1 : fix_digits; i > 0; i--) {
+        limit /= 10;
+        neg_limit /= 10;
     }
-    if (num_radix == 16 && isHexadecimalDigit(c)) {
-        n = isDigit(c) ? c - '0' : c - 'A' + 10;
-        const auto limit = num_limit / 16;
-        return num_value < limit || (num_value == limit && n <= (num_limit % 16));
+    num.quot = limit / 10;
+    num.rem = limit % 10;
+    num.neg_quot = neg_limit / 10;
+    num.neg_rem = neg_limit % 10;
+}
+
+void Impl::setCallback(Signed64Callback callback, uintptr_t context, uint_fast8_t radix,
+        int64_t min, int64_t max) {
+    this->callback.signed64 = callback;
+    setNumber<uint64_t>(
+            context, radix, limitOf<uint64_t>(max), negLimitOf<uint64_t>(min), true);
+    num64.low = lowOf<uint64_t>(min, max);
+}
+
+void Impl::setCallback(Signed64Callback callback, uintptr_t context, uint_fast8_t radix,
+        int64_t min, int64_t max, int64_t defval) {
+    setCallback(callback, context, radix, min, max);
+    setDefault(magnitude<uint64_t>(defval), defval < 0);
+}
+
+template <typename U>
+size_t Impl::printNumber(U number, int_fast8_t width, uint_fast8_t radix, bool negative) {
+    char buffer[numBufferSize(sizeof(U))];
+    Formatter fmt(echo, buffer, sizeof(buffer));
+    fmt.number(number, radix, width, negative);
+    return fmt.flush();
+}
+
+template <typename U>
+bool Impl::checkLimit(const Number<U> &num, uint_fast8_t n) const {
+    if (num_negative)
+        return num.value < num.neg_quot || (num.value == num.neg_quot && n <= num.neg_rem);
+    return num.value < num.quot || (num.value == num.quot && n <= num.rem);
+}
+
+void Impl::callNumber(const Number<uint32_t> &num, State state) {
+    const auto start = stamp();
+    if (num_signed) {
+        const auto value = num_negative ? uint32_t(0) - num.value : num.value;
+        callback.signed32(static_cast<int32_t>(value), context, state);
+    } else {
+        callback.number(num.value, context, state);
     }
-    return false;
+    countCallback(start, state);
 }
 
-void Impl::processNumber(char c) {
-    uint_fast8_t n;
-    if (checkLimit(c, n)) {
-        num_value *= num_radix;
-        num_value += n;
+void Impl::callNumber(const Number<uint64_t> &num, State state) {
+    const auto start = stamp();
+    if (num_signed) {
+        const auto value = num_negative ? uint64_t(0) - num.value : num.value;
+        callback.signed64(static_cast<int64_t>(value), context, state);
+    } else {
+        callback.number64(num.value, context, state);
+    }
+    countCallback(start, state);
+}
+
+void Impl::processFixed(char c) {
+    auto &num = fixed.num;
+    if (isDigit(c)) {
+        const uint_fast8_t n = c - '0';
+        const auto full = fix_point && fix_fraction == fix_digits;
+        if (!full && num_len < num_width && checkLimit(num, n)) {
+            num.value = num.value * 10 + n;
+            num_len++;
+            if (fix_point)
+                fix_fraction++;
+            setFixedLimit();
+            echo.print(c);
+        } else {
+            countDropped();
+        }
+        return;
+    }
+
+    State state;
+    if (c == '.' && fix_digits && !fix_point && num_len < num_width) {
+        fix_point = true;
         num_len++;
-        console->print(c);
+        setFixedLimit();
+        echo.print(c);
+        return;
+    } else if (c == '-' && num_len == 0 && !num_negative && fixed.neg_limit) {
+        num_negative = true;
+        echo.print(c);
+        return;
+    } else if (isBackspace(c)) {
+        if (num_len) {
+            if (fix_point && fix_fraction == 0) {
+                fix_point = false;
+            } else {
+                num.value /= 10;
+                if (fix_point)
+                    fix_fraction--;
+            }
+            num_len--;
+            setFixedLimit();
+            backspace(1);
+            return;
+        }
+        if (num_negative) {
+            num_negative = false;
+            backspace(1);
+            return;
+        }
+        state = CLI_DELETE;
+    } else if (isSpace(c) && num_len) {
+        auto value = num.value;
+        for (auto i = fix_point ? fix_digits - fix_fraction : fix_digits; i > 0; i--)
+            value *= 10;
+        if (value < num.low) {
+            countDropped();  // out of range
+            return;
+        }
+        num.value = value;
+        backspace(num_len + num_negative);
+        num_len = num_width;
+        fix_fraction = fix_digits;
+        fix_point = fix_digits != 0;
+        echoFixed(num_width + 1);
+        if (isNewline(c)) {
+            echo.print(' ');
+            state = CLI_NEWLINE;
+        } else {
+            echo.print(c);
+            state = CLI_SPACE;
+        }
+    } else if (isCancel(c)) {
+        echo.println(F(" cancel"));
+        state = CLI_CANCEL;
+    } else {
+        if (!isSpace(c))
+            countDropped();
+        return;
+    }
+    callNumber(num, state);
+}
+
+template <typename U, uint_fast8_t RADIX>
+void Impl::processNumber(char c) {
+    auto &num = number(U());
+    // |RADIX| is a compile time constant except 0.
+    const uint_fast8_t radix = RADIX ? RADIX : num_radix;
+    const char u = toUpperCase(c);
+    uint_fast8_t n = radix;
+    if (radix <= 10 && u >= '0' && u < radix + '0') {
+        n = u - '0';
+    } else if (radix == 16 && isHexadecimalDigit(u)) {
+        n = isDigit(u) ? u - '0' : u - 'A' + 10;
+    }
+    if (n < radix) {
+        if (num_len < num_width && checkLimit(num, n)) {
+            num.value *= radix;
+            num.value += n;
+            num_len++;
+            echo.print(c);
+        } else {
+            countDropped();
+        }
         return;
     }
 
     State state;
-    if (isBackspace(c)) {
+    if (c == '-' && num_signed && num_len == 0 && !num_negative &&
+            (num.neg_quot || num.neg_rem)) {
+        num_negative = true;
+        echo.print(c);
+        return;
+    } else if (isBackspace(c)) {
         if (num_len) {
-            num_value /= num_radix;
+            num.value /= radix;
             num_len--;
             backspace(1);
             return;
         }
+        if (num_negative) {
+            num_negative = false;
+            backspace(1);
+            return;
+        }
         state = CLI_DELETE;
     } else if (isSpace(c) && num_len) {
-        backspace(num_len);
+        if (num.value < num.low) {
+            countDropped();  // out of range
+            return;
+        }
+        backspace(num_len + num_negative);
         num_len = num_width;
-        printNum(num_value, num_len, num_radix, false);
+        printNumber(num.value, num_width + num_signed, radix, num_negative);
         if (isNewline(c)) {
-            console->print(' ');
+            echo.print(' ');
             state = CLI_NEWLINE;
         } else {
-            console->print(c);
+            echo.print(c);
             state = CLI_SPACE;
         }
     } else if (isCancel(c)) {
-        console->println(F(" cancel"));
+        echo.println(F(" cancel"));
         state = CLI_CANCEL;
     } else {
+        if (!isSpace(c))
+            countDropped();
         return;
     }
-    callback.number(num_value, context, state);
+    callNumber(num, state);
 }
 
 }  // namespace impl
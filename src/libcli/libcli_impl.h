@@ -19,6 +19,15 @@
 
 #include <Arduino.h>
 
+#include "libcli_command.h"
+#include "libcli_frame.h"
+#include "libcli_loader.h"
+#include "libcli_output.h"
+#include "libcli_printf.h"
+#include "libcli_ring.h"
+#include "libcli_stats.h"
+#include "libcli_str.h"
+#include "libcli_trie.h"
 #include "libcli_types.h"
 
 namespace libcli {
@@ -32,69 +41,291 @@ struct Impl final {
 private:
     friend Cli;
 
-    Impl() : console(nullptr), processor(&Impl::processNop), context(0) {}
+    Impl()
+        : console(nullptr),
+          input(nullptr),
+          framer(nullptr),
+          filter(nullptr),
+          idle(nullptr),
+          idle_context(0),
+          woken(false),
+          script(nullptr),
+          echo(output),
+          processor(&Impl::processNop),
+          ansi(nullptr),
+          esc(ESC_NONE),
+          context(0),
+          trie(nullptr),
+          completer(nullptr) {}
 
-    void begin(Stream &stream) { console = &stream; }
-    void loop() {
-        if (available())
-            (this->*processor)(read());
+    void begin(Stream &stream) {
+        console = &stream;
+        output.begin(stream);
     }
+    LoopStatus loop() {
+        woken = false;
+        uint_fast8_t status = CLI_IDLE;
+        if (!output.busy() && available()) {
+            const auto start = stamp();
+            countIn();
+            process(read());
+            countLoop(start);
+            status = CLI_CONSUMED;
+        }
+        output.drain();
+        return settle(status);
+    }
+    size_t loop(size_t maxBytes, uint32_t budget);
+    LoopStatus settle(uint_fast8_t status);
+    void process(char c) {
+        if (filter == nullptr || !(this->*filter)(c)) {
+            if (ansi == nullptr || (this->*ansi->escape)(c))
+                (this->*processor)(c);
+        }
+        if (echo.muted && script == nullptr)
+            echo.muted = false;  // the last byte of script has been processed.
+    }
+    void setScript(const char *text, bool progmem);
+    void setFramer(Framer *framer);
+    void setAnsi(bool enable);
 
     void setCallback(LetterCallback callback, uintptr_t context);
+    void setCallback(const CommandTable *commands, uintptr_t context);
+    void setCallback(const CommandTable *commands, uintptr_t context, char *buffer, size_t size);
     void setCallback(StringCallback callback, uintptr_t context, char *buffer, size_t size,
             bool hasDefval, bool word);
+    void setChunks(StringCallback callback, uintptr_t context, char *buffer, size_t size);
     void setCallback(NumberCallback callback, uintptr_t context, uint_fast8_t radix, uint32_t limit);
     void setCallback(NumberCallback callback, uintptr_t context, uint_fast8_t radix, uint32_t limit, uint32_t defval);
+    void setCallback(Number64Callback callback, uintptr_t context, uint_fast8_t radix, uint64_t limit);
+    void setCallback(Number64Callback callback, uintptr_t context, uint_fast8_t radix, uint64_t limit, uint64_t defval);
+    void setCallback(SignedCallback callback, uintptr_t context, uint_fast8_t radix, int32_t min, int32_t max);
+    void setCallback(SignedCallback callback, uintptr_t context, uint_fast8_t radix, int32_t min, int32_t max, int32_t defval);
+    void setCallback(Signed64Callback callback, uintptr_t context, uint_fast8_t radix, int64_t min, int64_t max);
+    void setCallback(Signed64Callback callback, uintptr_t context, uint_fast8_t radix, int64_t min, int64_t max, int64_t defval);
+    void setFixed(SignedCallback callback, uintptr_t context, uint_fast8_t fraction, int32_t min, int32_t max);
+    void setFixed(SignedCallback callback, uintptr_t context, uint_fast8_t fraction, int32_t min, int32_t max, int32_t defval);
+    void setLoader(Loader &loader);
+    void setTrie(const Trie &words);
 
     size_t backspace(int_fast8_t n);
     size_t printNum(uint32_t number, int_fast8_t width, uint_fast8_t radix, bool newline);
+    size_t printFixed(int32_t number, uint_fast8_t fraction, int_fast8_t width, bool newline);
     size_t printStr(const __FlashStringHelper *str, int_fast8_t width, bool newline);
     size_t printStr(const char *str, int_fast8_t width, bool newline);
+    size_t printStr(const Str &str, int_fast8_t width, bool newline);
+    size_t printStr_P(const char *text_P, size_t len, int_fast8_t width, bool newline);
+    size_t printFormat(const /*PROGMEM*/ char *program, const format::Arg *args);
+    size_t sendFrame(uint8_t id, const uint8_t *data, uint8_t size);
+    size_t printDump(uint32_t address, size_t len, const uint8_t *data, DumpReader reader,
+            uintptr_t context, int_fast8_t addrWidth, uint_fast8_t group, bool ascii);
 
     /** Delegate methods for Print. */
-    size_t write(uint_fast8_t val) { return console->write(val); }
-    size_t write(const uint8_t *buf, size_t size) { return console->write(buf, size); }
-    int availableForWrite() { return console->availableForWrite(); }
+    size_t write(uint_fast8_t val) { return output.write(val); }
+    size_t write(const uint8_t *buf, size_t size) { return output.write(buf, size); }
+    int availableForWrite() { return output.availableForWrite(); }
 
-    /** Delegate methods for Stream. */
-    int available() { return console->available(); }
-    int read() { return console->read(); }
-    int peek() { return console->peek(); }
-    void flush() { return console->flush(); }
+    /**
+     * Delegate methods for Stream; input comes from |script| while running, then from |input|
+     * ring if any.
+     */
+    int available() {
+        if (script)
+            return 1;
+        return input ? input->available() : console->available();
+    }
+    int read() {
+        if (script)
+            return readScript();
+        return input ? input->read() : console->read();
+    }
+    int peek() {
+        if (script)
+            return peekScript();
+        return input ? input->peek() : console->peek();
+    }
+    void flush() {
+        output.flushBuffer();
+        console->flush();
+    }
+
+#if defined(LIBCLI_STATS)
+    const Stats &getStats() {
+        stats.bytesOut = output.bytesOut;
+        return stats;
+    }
+    void resetStats() {
+        stats = Stats();
+        output.bytesOut = 0;
+    }
+#endif
 
     using Processor = void (Impl::*)(char c);
+    /** Returns true if |c| is consumed before |processor|. */
+    using Filter = bool (Impl::*)(char c);
 
     Stream *console;
+    Ring *input;
+    Framer *framer;
+    /** Installed by |setFramer| so that Framer is linked only when it is used. */
+    Filter filter;
+    IdleHook idle;
+    uintptr_t idle_context;
+    /** Set by |Cli::wake|, possibly in an interrupt handler, and cleared by |loop|. */
+    volatile bool woken;
+    /** Script in RAM or PROGMEM, which is nullptr unless running. */
+    const char *script;
+    bool script_P;
+    Output output;
+    Echo echo;
     Processor processor;
+    /** Line editing of ANSI terminal mode, which is installed by |setAnsi|. */
+    struct Terminal {
+        bool (Impl::*escape)(char &c);
+        bool (Impl::*edit)(char c);
+        size_t (Impl::*erase)(int_fast8_t n);
+    };
+    /** Terminal of ANSI mode or nullptr, and state of escape sequence being decoded. */
+    const Terminal *ansi;
+    enum : uint8_t {
+        ESC_NONE,
+        ESC_START,
+        ESC_CSI,
+    } esc;
+    uint8_t esc_param;
     union {
         LetterCallback letter;
         StringCallback string;
         NumberCallback number;
+        Number64Callback number64;
+        SignedCallback signed32;
+        Signed64Callback signed64;
+        const /*PROGMEM*/ CommandTable *commands;
+        Loader *loader;
     } callback;
     uintptr_t context;
 
     size_t str_limit;
     size_t str_len;
+    /** Cursor position in |str_buffer|, which is |str_len| unless editing in ANSI mode. */
+    size_t str_pos;
     bool str_word;
+    /** Dispatches a command name instead of |callback.string|, which is installed by a table. */
+    void (Impl::*str_command)(State state);
+    bool str_chunk;
     char *str_buffer;
+    /** Words to complete |str_buffer| by tab, or nullptr. */
+    const /*PROGMEM*/ Trie *trie;
+    /** Installed by |setTrie| so that completion is linked only when it is used. */
+    void (Impl::*completer)();
 
-    uint32_t num_value;
-    uint32_t num_limit;
+    /**
+     * Number input state; |quot| and |rem| are |limit| divided by radix, and |low| is the least
+     * magnitude which is accepted.
+     */
+    template <typename U>
+    struct Number {
+        U value;
+        U quot;
+        U neg_quot;
+        U low;
+        uint8_t rem;
+        uint8_t neg_rem;
+    };
+    /**
+     * Fixed-point input state; |limit| and |neg_limit| are of the scaled value, and |num| is
+     * divided by what remains to be inputted.
+     */
+    struct Fixed {
+        Number<uint32_t> num;
+        uint32_t limit;
+        uint32_t neg_limit;
+    };
+    union {
+        Number<uint32_t> num32;
+        Number<uint64_t> num64;
+        Fixed fixed;
+    };
     uint8_t num_radix;
     uint8_t num_len;
     uint8_t num_width;
+    bool num_signed;
+    bool num_negative;
+    /** Number of fraction digits of fixed-point, and those which are inputted after point. */
+    uint8_t fix_digits;
+    uint8_t fix_fraction;
+    bool fix_point;
+
+    /** Instrumentation hooks, which are empty unless LIBCLI_STATS is defined. */
+#if defined(LIBCLI_STATS)
+    Stats stats = Stats();
+
+    static uint32_t stamp() { return micros(); }
+    void countIn() { stats.bytesIn++; }
+    void countDropped() { stats.dropped++; }
+    void countLoop(uint32_t start) { stats.loops.add(micros() - start); }
+    void countLetter(uint32_t start) {
+        stats.letters++;
+        stats.callbacks.add(micros() - start);
+    }
+    void countCallback(uint32_t start, State state) {
+        stats.states[state]++;
+        stats.callbacks.add(micros() - start);
+    }
+#else
+    static uint32_t stamp() { return 0; }
+    void countIn() {}
+    void countDropped() {}
+    void countLoop(uint32_t) {}
+    void countLetter(uint32_t) {}
+    void countCallback(uint32_t, State) {}
+#endif
 
     void setProcessor(Processor processor_, uintptr_t context_) {
         processor = processor_;
         context = context_;
     }
+    char peekScript() const { return script_P ? pgm_read_byte(script) : *script; }
+    int readScript();
     void processNop(char c) { (void)c; }
+    bool acceptFrame(char c);
     void processLetter(char c);
     void processString(char c);
+    bool escape(char &c);
+    bool editString(char c);
+    size_t eraseLeft(int_fast8_t n);
+    size_t cursorLeft(size_t n);
+    void endOfString();
+    void redrawString(bool erase);
+    void processCommand(char c);
+    void processLoad(char c) { callback.loader->accept(c); }
+    void doneString(State state);
+    void doneCommand(State state);
+    /** True if string input into |buffer| continues, which a callback may have replaced. */
+    bool reading(const char *buffer) const {
+        return processor == &Impl::processString && str_buffer == buffer;
+    }
+    void complete();
+    uint_fast8_t childOf(const TrieNode *nodes, uint_fast8_t node) const;
+    void listWords(const TrieNode *nodes, uint_fast8_t node, uint_fast8_t child);
+    bool dispatch(const char *name, State state);
+    Number<uint32_t> &number(uint32_t) { return num32; }
+    Number<uint64_t> &number(uint64_t) { return num64; }
+    template <typename U>
+    void setNumber(uintptr_t context, uint_fast8_t radix, U limit, U neg_limit, bool sign);
+    template <typename U>
+    void setDefault(U value, bool negative);
+    template <typename U, uint_fast8_t RADIX>
     void processNumber(char c);
-    bool checkLimit(char c, uint_fast8_t &n) const;
-    size_t pad_left(int_fast8_t len, int_fast8_t width, char pad);
-    size_t pad_right(int_fast8_t len, int_fast8_t width, char pad);
+    template <typename U>
+    bool checkLimit(const Number<U> &num, uint_fast8_t n) const;
+    void processFixed(char c);
+    void setFixedLimit();
+    size_t echoFixed(int_fast8_t width);
+    void callNumber(const Number<uint32_t> &num, State state);
+    void callNumber(const Number<uint64_t> &num, State state);
+    template <typename U>
+    size_t printNumber(U number, int_fast8_t width, uint_fast8_t radix, bool negative);
 
     /** No copy constructor. */
     Impl(Impl const &) = delete;
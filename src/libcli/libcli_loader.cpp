@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "libcli_loader.h"
+
+namespace libcli {
+
+namespace {
+
+/** Returns the value of hexadecimal digit |c|, or -1. */
+int_fast8_t hexValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+/** Bytes of address of S-record |type|, or 0 if unknown. */
+uint8_t addressLength(char type) {
+    switch (type) {
+    case '0':
+    case '1':
+    case '5':
+    case '9':
+        return 2;
+    case '2':
+    case '6':
+    case '8':
+        return 3;
+    case '3':
+    case '7':
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+}  // namespace
+
+void Loader::reset() {
+    _state = IDLE;
+    _base = 0;
+    _start = 0;
+    _errors = 0;
+    _records = 0;
+}
+
+void Loader::accept(char c) {
+    if (c == '\x03') {
+        _sink(0, nullptr, 0, _context, CLI_CANCEL);
+        reset();  // a next file starts afresh.
+        return;
+    }
+    if (_state == IDLE) {
+        // Anything between records, such as newline, is ignored.
+        if (c == ':') {
+            begin(false, 2, 0);
+        } else if (c == 'S') {
+            _state = TYPE;
+        }
+    } else if (_state == TYPE) {
+        const auto len = addressLength(c);
+        if (len) {
+            begin(true, len, c - '0');
+        } else {
+            discard();
+        }
+    } else {
+        const auto v = hexValue(c);
+        if (v < 0) {
+            discard();
+        } else if (_low) {
+            _low = false;
+            decode(_byte | v);
+        } else {
+            _byte = v << 4;
+            _low = true;
+        }
+    }
+}
+
+void Loader::begin(bool srec, uint8_t addrLen, uint8_t type) {
+    _state = DIGITS;
+    _srec = srec;
+    _type = type;
+    _low = false;
+    _sum = 0;
+    _pos = 0;
+    _addrLen = addrLen;
+    // Intel HEX has a type byte after address.
+    _dataPos = 1 + addrLen + (srec ? 0 : 1);
+    _address = 0;
+}
+
+void Loader::discard() {
+    _state = IDLE;
+    _errors++;
+}
+
+void Loader::decode(uint8_t b) {
+    _sum += b;
+    if (_pos == 0) {
+        // S-record counts address and checksum as well as data.
+        if (_srec && b < _addrLen + 1) {
+            discard();
+            return;
+        }
+        _dataLen = _srec ? b - _addrLen - 1 : b;
+    } else if (_pos <= _addrLen) {
+        _address = (_address << 8) | b;
+    } else if (_pos < _dataPos) {
+        _type = b;
+    } else if (_pos < _dataPos + _dataLen) {
+        const size_t i = _pos - _dataPos;
+        if (i < _size)
+            _buffer[i] = b;
+    } else {
+        // Intel HEX sums up to zero, and S-record sums up to 0xFF.
+        const uint8_t sum = _srec ? 0xFF : 0;
+        if (_sum == sum && _dataLen <= _size) {
+            _state = IDLE;
+            dispatch();
+        } else {
+            discard();
+        }
+        return;
+    }
+    _pos++;
+}
+
+uint32_t Loader::dataValue() const {
+    uint32_t value = 0;
+    for (uint_fast8_t i = 0; i < _dataLen; i++)
+        value = (value << 8) | _buffer[i];
+    return value;
+}
+
+void Loader::dispatch() {
+    if (_srec) {
+        if (_type >= 1 && _type <= 3) {
+            _records++;
+            _sink(_address, _buffer, _dataLen, _context, CLI_CONTINUE);
+        } else if (_type >= 7) {
+            _sink(_address, _buffer, 0, _context, CLI_NEWLINE);
+        }
+        return;  // S0 header and S5/S6 count are ignored.
+    }
+    // Data length which each type of Intel HEX record must have.
+    static constexpr uint8_t LENGTH[] = {0, 0, 2, 4, 2, 4};
+    if (_type >= sizeof(LENGTH) || (_type != 0 && _dataLen != LENGTH[_type])) {
+        _errors++;
+        return;
+    }
+    switch (_type) {
+    case 0:
+        _records++;
+        _sink(_base + _address, _buffer, _dataLen, _context, CLI_CONTINUE);
+        break;
+    case 1:
+        _sink(_start, _buffer, 0, _context, CLI_NEWLINE);
+        break;
+    case 2:  // extended segment address
+        _base = dataValue() << 4;
+        break;
+    case 3:  // start segment address; CS:IP
+        _start = ((dataValue() >> 16) << 4) + (dataValue() & 0xFFFF);
+        break;
+    case 4:  // extended linear address
+        _base = dataValue() << 16;
+        break;
+    case 5:  // start linear address
+        _start = dataValue();
+        break;
+    }
+}
+
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "libcli_output.h"
+
+namespace libcli {
+namespace impl {
+
+void Output::setBuffer(uint8_t *buffer_, size_t size_, bool blocking_) {
+    flushBuffer();
+    buffer = buffer_;
+    size = buffer_ ? size_ : 0;
+    blocking = blocking_ || size == 0;
+    paced = console && console->availableForWrite() > 0;
+    lost = 0;
+}
+
+void Output::send(size_t n) {
+    sent(console->write(buffer, n));
+    len -= n;
+    memmove(buffer, buffer + n, len);
+}
+
+void Output::drain() {
+    if (len) {
+        const auto avail = console->availableForWrite();
+        if (avail > 0) {
+            paced = true;
+            send(static_cast<size_t>(avail) < len ? avail : len);
+        } else if (!paced) {
+            send(len);  // |console| doesn't implement availableForWrite.
+        }
+    }
+}
+
+void Output::flushBuffer() {
+    if (len)
+        send(len);
+}
+
+void Output::makeRoom() {
+    drain();
+    if (len == size && blocking)
+        send(len);  // |console| can't accept; have to wait.
+}
+
+size_t Output::write(uint8_t val) {
+    if (size == 0)
+        return sent(console->write(val));
+    if (len == size) {
+        makeRoom();
+        if (len == size) {
+            lost++;
+            return 0;
+        }
+    }
+    buffer[len++] = val;
+    if (val == '\n')
+        drain();
+    return 1;
+}
+
+size_t Output::write(const uint8_t *buf, size_t n) {
+    if (size == 0)
+        return sent(console->write(buf, n));
+    const auto newline = memchr(buf, '\n', n) != nullptr;
+    auto remain = n;
+    while (remain) {
+        if (len == size) {
+            makeRoom();
+            if (len == size) {
+                lost += remain;
+                break;
+            }
+        }
+        const auto chunk = (size - len) < remain ? (size - len) : remain;
+        memcpy(buffer + len, buf, chunk);
+        len += chunk;
+        buf += chunk;
+        remain -= chunk;
+    }
+    if (newline)
+        drain();
+    return n - remain;
+}
+
+int Output::availableForWrite() {
+    return size ? size - len : console->availableForWrite();
+}
+
+}  // namespace impl
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_OUTPUT_H__
+#define __LIBCLI_OUTPUT_H__
+
+#include <Arduino.h>
+
+namespace libcli {
+namespace impl {
+
+/**
+ * Output stage of libcli. When a buffer is supplied, small writes are combined in the buffer
+ * and sent to |console| with bulk write. In non-blocking mode, a write which doesn't fit in
+ * the buffer is dropped rather than waiting for |console|.
+ */
+struct Output final : Print {
+    Output()
+        : console(nullptr),
+          buffer(nullptr),
+          size(0),
+          len(0),
+          blocking(true),
+          paced(false),
+          lost(0) {}
+
+    void begin(Stream &stream) { console = &stream; }
+    void setBuffer(uint8_t *buffer, size_t size, bool blocking);
+
+    /** True when non-blocking buffer is more than half full; input should be deferred. */
+    bool busy() const { return !blocking && len > size / 2; }
+    /** Number of bytes in the buffer waiting to be sent. */
+    size_t pending() const { return len; }
+    /** Number of bytes dropped in non-blocking mode. */
+    uint32_t dropped() const { return lost; }
+
+    /** Write buffered bytes as many as |console| can accept without blocking. */
+    void drain();
+    /** Write all buffered bytes. */
+    void flushBuffer();
+
+    using Print::write;
+    size_t write(uint8_t val) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    int availableForWrite() override;
+
+#if defined(LIBCLI_STATS)
+    /** Bytes sent to |console|. */
+    uint32_t bytesOut = 0;
+#endif
+
+private:
+    Stream *console;
+    uint8_t *buffer;
+    size_t size;
+    size_t len;
+    bool blocking;
+    /** True once |console| reports room by availableForWrite; otherwise it can't pace output. */
+    bool paced;
+    uint32_t lost;
+
+    void makeRoom();
+    void send(size_t n);
+    size_t sent(size_t n) {
+#if defined(LIBCLI_STATS)
+        bytesOut += n;
+#endif
+        return n;
+    }
+
+    /** No copy constructor. */
+    Output(Output const &) = delete;
+    /** No assignment operator. */
+    void operator=(Output const &) = delete;
+};
+
+/** Echo back stage of libcli, which passes through to Output unless muted. */
+struct Echo final : Print {
+    Echo(Output &output) : muted(false), output(output) {}
+
+    using Print::write;
+    size_t write(uint8_t val) override { return muted ? 1 : output.write(val); }
+    size_t write(const uint8_t *buf, size_t size) override {
+        return muted ? size : output.write(buf, size);
+    }
+
+    bool muted;
+
+private:
+    Output &output;
+
+    /** No copy constructor. */
+    Echo(Echo const &) = delete;
+    /** No assignment operator. */
+    void operator=(Echo const &) = delete;
+};
+
+}  // namespace impl
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "libcli_tokens.h"
+
+namespace libcli {
+
+namespace {
+
+bool isQuote(char c) {
+    return c == '"' || c == '\'';
+}
+
+/** Returns the value of digit |c|, or 0xFF if it isn't. */
+uint_fast8_t digitOf(char c) {
+    if (isDigit(c))
+        return c - '0';
+    const char u = toUpperCase(c);
+    return (u >= 'A' && u <= 'Z') ? u - 'A' + 10 : 0xFF;
+}
+
+/** Parse |token| in |radix| within |limit|, which is divided beforehand as |checkLimit|. */
+template <typename U>
+bool parse(const Token &token, uint_fast8_t radix, U limit, U &value) {
+    if (token.len == 0)
+        return false;
+    const U quot = limit / radix;
+    const uint_fast8_t rem = limit % radix;
+    U v = 0;
+    for (auto p = token.text; *p; p++) {
+        const auto n = digitOf(*p);
+        if (n >= radix)
+            return false;
+        if (v > quot || (v == quot && n > rem))
+            return false;
+        v = v * radix + n;
+    }
+    value = v;
+    return true;
+}
+
+}  // namespace
+
+int Tokenizer::split(char *line) {
+    _count = 0;
+    auto p = line;
+    for (;;) {
+        while (isSpace(*p))
+            p++;
+        if (*p == 0)
+            return _count;
+        if (_count == _capacity)
+            return -1;
+        char *start;
+        char *out;
+        bool more;
+        if (isQuote(*p)) {
+            const auto quote = *p++;
+            start = out = p;
+            while (*p != quote) {
+                if (*p == '\\' && p[1])
+                    p++;
+                if (*p == 0)
+                    return -1;
+                *out++ = *p++;
+            }
+            more = true;  // closing quote
+        } else {
+            start = out = p;
+            while (*p && !isSpace(*p))
+                out = ++p;
+            more = *p != 0;
+        }
+        *out = 0;
+        if (more)
+            p++;
+        _tokens[_count].text = start;
+        _tokens[_count].len = out - start;
+        _count++;
+    }
+}
+
+bool Tokenizer::num(size_t index, uint_fast8_t radix, uint32_t &value, uint32_t limit) const {
+    return index < _count && parse(_tokens[index], radix, limit, value);
+}
+
+bool Tokenizer::num(size_t index, uint_fast8_t radix, uint64_t &value, uint64_t limit) const {
+    return index < _count && parse(_tokens[index], radix, limit, value);
+}
+
+bool Tokenizer::dec(size_t index, int32_t &value, int32_t min, int32_t max) const {
+    if (index >= _count)
+        return false;
+    auto token = _tokens[index];
+    const auto negative = token.len && *token.text == '-';
+    if (negative) {
+        token.text++;
+        token.len--;
+    }
+    uint32_t v;
+    if (negative) {
+        if (min >= 0 || !parse(token, 10, uint32_t(0) - static_cast<uint32_t>(min), v))
+            return false;
+        value = static_cast<int32_t>(uint32_t(0) - v);
+    } else {
+        if (max < 0 || !parse(token, 10, static_cast<uint32_t>(max), v))
+            return false;
+        value = static_cast<int32_t>(v);
+    }
+    return value >= min && value <= max;
+}
+
+int Tokenizer::keyword(size_t index, const __FlashStringHelper *keywords) const {
+    if (index >= _count)
+        return -1;
+    const auto &token = _tokens[index];
+    auto p = reinterpret_cast<const char *>(keywords);
+    for (int i = 0;; i++) {
+        size_t len = 0;
+        char c;
+        while ((c = pgm_read_byte(p + len)) != 0 && c != '|')
+            len++;
+        if (len == token.len && strncmp_P(token.text, p, len) == 0)
+            return i;
+        if (c == 0)
+            return -1;
+        p += len + 1;
+    }
+}
+
+}  // namespace libcli
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_COMMAND_H__
+#define __LIBCLI_COMMAND_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+#include "libcli_indices.h"
+#include "libcli_types.h"
+
+namespace libcli {
+
+/**
+ * Callback function of a command. |name| is the inputted command name and |state| is what
+ * terminates it. A letter command is called with CLI_SPACE.
+ */
+using CommandHandler = void (*)(const char *name, uintptr_t context, State state);
+
+/** Max length of a command name. */
+constexpr size_t COMMAND_NAME_MAX = 11;
+
+/**
+ * Max number of commands in a table. An 8-bit perfect hash of more names into at most 256
+ * slots is unlikely to be found among 256 seeds, and the search exceeds compilers' limits of
+ * constexpr evaluation.
+ */
+constexpr size_t COMMAND_TABLE_MAX = 40;
+
+/**
+ * An entry of a command table. An entry with empty |name| is called for unknown command, and
+ * CLI_DELETE and CLI_CANCEL.
+ */
+struct Command {
+    char name[COMMAND_NAME_MAX + 1];
+    CommandHandler handler;
+};
+
+/** Command table with perfect hash index, which is placed in PROGMEM. */
+struct CommandTable {
+    const /*PROGMEM*/ Command *commands;
+    const /*PROGMEM*/ uint8_t *slots;
+    uint8_t shift;
+    uint8_t seed;
+    uint8_t fallback;
+};
+
+namespace command {
+
+/** No command in a slot. */
+constexpr uint8_t NONE = UINT8_MAX;
+
+constexpr uint8_t mix(uint8_t x) {
+    return x ^ (x >> 5);
+}
+
+constexpr uint8_t hashStep(uint8_t hash, char c) {
+    return mix(static_cast<uint8_t>((hash ^ static_cast<uint8_t>(c)) * 167U));
+}
+
+constexpr uint8_t hash(const char *name, uint8_t hash_) {
+    return *name ? hash(name + 1, hashStep(hash_, *name)) : hash_;
+}
+
+/** Bits of hash slot index; number of slots is more than 4 times of |n| up to 256. */
+constexpr uint8_t slotBits(size_t n, uint8_t bits = 0) {
+    return (bits == 8 || (1U << bits) >= 4 * n) ? bits : slotBits(n, bits + 1);
+}
+
+/** Right shift of hash to get slot index. */
+constexpr uint8_t shiftOf(size_t n) {
+    return 8 - slotBits(n);
+}
+
+constexpr uint8_t slot(const Command *t, size_t i, uint8_t seed, uint8_t shift) {
+    return hash(t[i].name, seed) >> shift;
+}
+
+template <size_t N>
+struct Slots {
+    uint8_t slot[N];
+};
+
+/** Hashes of all names by |seed|, so that a search for seed hashes each name only once. */
+template <size_t... I>
+constexpr Slots<sizeof...(I)> hashes(const Command *t, uint8_t seed, Indices<I...>) {
+    return Slots<sizeof...(I)>{{hash(t[I].name, seed)...}};
+}
+
+template <size_t N>
+constexpr bool collide(const Command *t, const Slots<N> &h, size_t i, size_t j, uint8_t shift) {
+    return j < N && ((t[j].name[0] && (h.slot[i] >> shift) == (h.slot[j] >> shift)) ||
+                            collide(t, h, i, j + 1, shift));
+}
+
+template <size_t N>
+constexpr bool perfect(const Command *t, const Slots<N> &h, uint8_t shift, size_t i = 0) {
+    return i >= N || ((t[i].name[0] == 0 || !collide(t, h, i, i + 1, shift)) &&
+                             perfect(t, h, shift, i + 1));
+}
+
+/** Returns a seed which makes hash of |N| names perfect, or NONE. */
+template <size_t N>
+constexpr uint8_t findSeed(const Command *t, uint8_t shift, uint8_t seed = 0) {
+    return perfect(t, hashes(t, seed, typename MakeIndices<N>::type()), shift)
+                   ? seed
+                   : (seed == NONE ? NONE : findSeed<N>(t, shift, seed + 1));
+}
+
+/** Returns the largest shift, which is at most |shift|, that has a perfect hash seed. */
+template <size_t N>
+constexpr uint8_t findShift(const Command *t, uint8_t shift) {
+    return (shift == 0 || findSeed<N>(t, shift) != NONE) ? shift : findShift<N>(t, shift - 1);
+}
+
+constexpr uint8_t indexOf(
+        const Command *t, size_t n, uint8_t seed, uint8_t shift, size_t s, size_t i = 0) {
+    return i >= n ? NONE
+                  : ((t[i].name[0] && slot(t, i, seed, shift) == s)
+                                    ? i
+                                    : indexOf(t, n, seed, shift, s, i + 1));
+}
+
+constexpr uint8_t fallbackOf(const Command *t, size_t n, size_t i = 0) {
+    return i >= n ? NONE : (t[i].name[0] == 0 ? i : fallbackOf(t, n, i + 1));
+}
+
+template <size_t... I>
+constexpr Slots<sizeof...(I)> makeSlots(
+        const Command *t, size_t n, uint8_t seed, uint8_t shift, Indices<I...>) {
+    return Slots<sizeof...(I)>{{indexOf(t, n, seed, shift, I)...}};
+}
+
+}  // namespace command
+}  // namespace libcli
+
+/**
+ * Define CommandTable |name| in PROGMEM from constexpr Command array |commands|, which also
+ * must be in PROGMEM.
+ */
+#define LIBCLI_COMMAND_TABLE(name, commands)                                                  \
+    static constexpr size_t name##_size_ = sizeof(commands) / sizeof(commands[0]);            \
+    static_assert(name##_size_ <= libcli::COMMAND_TABLE_MAX, "too many commands");            \
+    static constexpr uint8_t name##_shift_ = libcli::command::findShift<name##_size_>(        \
+            commands, libcli::command::shiftOf(name##_size_));                                \
+    static constexpr uint8_t name##_seed_ =                                                   \
+            libcli::command::findSeed<name##_size_>(commands, name##_shift_);                 \
+    static_assert(name##_seed_ != libcli::command::NONE, "no perfect hash for command names"); \
+    static constexpr auto name##_slots_ PROGMEM =                                             \
+            libcli::command::makeSlots(commands, name##_size_, name##_seed_, name##_shift_,   \
+                    libcli::MakeIndices<(256U >> name##_shift_)>::type());                    \
+    static constexpr libcli::CommandTable name PROGMEM = {commands, name##_slots_.slot,       \
+            name##_shift_, name##_seed_, libcli::command::fallbackOf(commands, name##_size_)}
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_FORM_H__
+#define __LIBCLI_FORM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+#include "libcli_types.h"
+
+namespace libcli {
+
+class Cli;
+
+/**
+ * A numeric field of a form, which is placed in PROGMEM. A signed field accepts between |min|
+ * and |max|, otherwise up to |max|. |defval| is the value when the field is omitted by newline.
+ */
+struct Field {
+    uint8_t radix;
+    bool sign;
+    int32_t min;
+    uint32_t max;
+    uint32_t defval;
+};
+
+namespace field {
+
+constexpr Field num(uint8_t radix, uint32_t limit = UINT32_MAX, uint32_t defval = 0) {
+    return Field{radix, false, 0, limit, defval};
+}
+constexpr Field hex(uint32_t limit = UINT32_MAX, uint32_t defval = 0) {
+    return num(16, limit, defval);
+}
+constexpr Field dec(uint32_t limit = UINT32_MAX, uint32_t defval = 0) {
+    return num(10, limit, defval);
+}
+constexpr Field signedNum(uint8_t radix, int32_t min = INT32_MIN, int32_t max = INT32_MAX,
+        int32_t defval = 0) {
+    return Field{radix, true, min, static_cast<uint32_t>(max), static_cast<uint32_t>(defval)};
+}
+constexpr Field signedDec(int32_t min = INT32_MIN, int32_t max = INT32_MAX, int32_t defval = 0) {
+    return signedNum(10, min, max, defval);
+}
+
+}  // namespace field
+
+class Form;
+
+/**
+ * Callback function of a form. |state| is CLI_SPACE or CLI_NEWLINE which completes the form,
+ * or CLI_CANCEL.
+ */
+using FormCallback = void (*)(const Form &form, uintptr_t context, State state);
+
+/**
+ * A sequence of numeric fields read one by one. Space advances to the next field, backspace on
+ * an empty field goes back to the previous one with its value, and newline completes the form
+ * where omitted fields have their default values.
+ */
+class Form {
+public:
+    /** Number of fields. */
+    size_t size() const { return _size; }
+    /** Number of fields which are inputted. */
+    size_t count() const { return _count; }
+    /** Value of field at |index|. */
+    uint32_t value(size_t index) const { return _values[index]; }
+    int32_t signedValue(size_t index) const { return static_cast<int32_t>(_values[index]); }
+
+protected:
+    Form(const /*PROGMEM*/ Field *fields, size_t size, uint32_t *values, FormCallback callback,
+            uintptr_t context)
+        : _fields(fields),
+          _size(size),
+          _values(values),
+          _callback(callback),
+          _context(context),
+          _cli(nullptr),
+          _count(0) {}
+
+private:
+    friend Cli;
+
+    const /*PROGMEM*/ Field *const _fields;
+    const size_t _size;
+    uint32_t *const _values;
+    const FormCallback _callback;
+    const uintptr_t _context;
+    Cli *_cli;
+    size_t _count;
+
+    void begin(Cli &cli);
+    void read(bool hasDefval);
+    void next(uint32_t value, State state);
+    static void handleNumber(uint32_t number, uintptr_t context, State state);
+    static void handleSigned(int32_t number, uintptr_t context, State state);
+
+    /** No copy constructor. */
+    Form(Form const &) = delete;
+    /** No assignment operator. */
+    void operator=(Form const &) = delete;
+};
+
+/** Form which has values of |N| fields. */
+template <size_t N>
+class FormBuffer final : public Form {
+public:
+    FormBuffer(const /*PROGMEM*/ Field (&fields)[N], FormCallback callback, uintptr_t context)
+        : Form(fields, N, _storage, callback, context) {}
+
+private:
+    uint32_t _storage[N];
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
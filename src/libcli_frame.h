@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_FRAME_H__
+#define __LIBCLI_FRAME_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+namespace libcli {
+
+/**
+ * A binary frame; STX, |size|, |id|, |size| bytes of payload with little-endian fields, and
+ * CRC-16/CCITT-FALSE of |size|, |id| and payload. CRC is sent in big-endian so that CRC of
+ * the whole frame after STX becomes zero.
+ */
+struct Frame {
+    /**
+     * Start of frame, which never appears in UTF-8 text, so that no key of interactive input,
+     * including control keys, starts a frame.
+     */
+    static constexpr uint8_t STX = 0xFE;
+    /** Overhead bytes of a frame other than payload. */
+    static constexpr size_t OVERHEAD = 5;
+
+    uint8_t id;
+    uint8_t size;
+    const uint8_t *data;
+
+    /** Little-endian fields at |offset| of payload. */
+    uint8_t u8(uint8_t offset) const { return data[offset]; }
+    uint16_t u16(uint8_t offset) const { return data[offset] | (uint16_t(data[offset + 1]) << 8); }
+    uint32_t u32(uint8_t offset) const { return u16(offset) | (uint32_t(u16(offset + 2)) << 16); }
+    int8_t s8(uint8_t offset) const { return static_cast<int8_t>(u8(offset)); }
+    int16_t s16(uint8_t offset) const { return static_cast<int16_t>(u16(offset)); }
+    int32_t s32(uint8_t offset) const { return static_cast<int32_t>(u32(offset)); }
+
+    /** Returns CRC-16/CCITT-FALSE of |crc| updated by |data|. */
+    static uint16_t crc16(uint16_t crc, uint8_t data);
+    static constexpr uint16_t CRC_INIT = 0xFFFF;
+};
+
+/** Handler function of a frame. */
+using FrameHandler = void (*)(const Frame &frame, uintptr_t context);
+
+/**
+ * An entry of frame handler table, which is placed in PROGMEM. |size| is the expected payload
+ * size, or ANY_SIZE.
+ */
+struct FrameCommand {
+    static constexpr uint8_t ANY_SIZE = UINT8_MAX;
+
+    uint8_t id;
+    uint8_t size;
+    FrameHandler handler;
+};
+
+/**
+ * Receiver of binary frames interleaved with interactive input. A frame starts with STX and
+ * the rest of it is consumed without echo back. A frame with wrong CRC, an unknown id or
+ * unexpected size, or which pauses longer than TIMEOUT_MS, is discarded and counted.
+ */
+class Framer {
+public:
+    static constexpr uint16_t TIMEOUT_MS = 100;
+
+    /** Returns true if |c| is consumed as a part of a frame. */
+    bool accept(uint8_t c);
+
+    /** True while receiving a frame. */
+    bool receiving() const { return _pos != 0; }
+
+    /** Number of discarded frames. */
+    uint16_t errors() const { return _errors; }
+
+protected:
+    Framer(uint8_t *buffer, size_t size, const /*PROGMEM*/ FrameCommand *commands, size_t n,
+            uintptr_t context)
+        : _buffer(buffer),
+          _size(size),
+          _commands(commands),
+          _count(n),
+          _context(context),
+          _pos(0),
+          _crc(0),
+          _last(0),
+          _errors(0) {}
+
+private:
+    uint8_t *const _buffer;
+    const size_t _size;
+    const /*PROGMEM*/ FrameCommand *const _commands;
+    const size_t _count;
+    const uintptr_t _context;
+    /** Position in a frame of next byte; 0 is STX. */
+    uint16_t _pos;
+    uint8_t _frameSize;
+    uint8_t _id;
+    uint16_t _crc;
+    /** millis() when the last byte is received. */
+    uint16_t _last;
+    uint16_t _errors;
+
+    void dispatch();
+
+    /** No copy constructor. */
+    Framer(Framer const &) = delete;
+    /** No assignment operator. */
+    void operator=(Framer const &) = delete;
+};
+
+/** Framer which can receive up to |SIZE| bytes of payload. */
+template <size_t SIZE>
+class FrameBuffer final : public Framer {
+    static_assert(SIZE <= UINT8_MAX, "SIZE is too large");
+
+public:
+    template <size_t N>
+    FrameBuffer(const /*PROGMEM*/ FrameCommand (&commands)[N], uintptr_t context)
+        : Framer(_storage, SIZE, commands, N, context) {}
+
+private:
+    uint8_t _storage[SIZE];
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_LOADER_H__
+#define __LIBCLI_LOADER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+#include "libcli_types.h"
+
+namespace libcli {
+
+/**
+ * Sink function of a loader. A data record calls back with CLI_CONTINUE and its |size| bytes of
+ * |data| at |address|. The end of file calls back with CLI_NEWLINE, where |address| is the start
+ * address if any and |size| is zero. Control-C calls back with CLI_CANCEL, and then resets the
+ * loader.
+ */
+using RecordSink = void (*)(uint32_t address, const uint8_t *data, uint8_t size,
+        uintptr_t context, State state);
+
+/**
+ * Decoder of Intel HEX and Motorola S-record, which consumes input byte by byte without echo
+ * back. Only data bytes of a record are buffered, and they are delivered after its checksum is
+ * verified. A record with wrong checksum, a malformed one, or one which has more data than the
+ * buffer, is discarded and counted.
+ */
+class Loader {
+public:
+    /** Consume |c| of records. */
+    void accept(char c);
+
+    /** Number of discarded records. */
+    uint16_t errors() const { return _errors; }
+
+    /** Number of delivered data records. */
+    uint16_t records() const { return _records; }
+
+    /** Forget the extended address and counters, to start loading a new file. */
+    void reset();
+
+protected:
+    Loader(uint8_t *buffer, size_t size, RecordSink sink, uintptr_t context)
+        : _buffer(buffer), _size(size), _sink(sink), _context(context) {
+        reset();
+    }
+
+private:
+    uint8_t *const _buffer;
+    const size_t _size;
+    const RecordSink _sink;
+    const uintptr_t _context;
+
+    /** Decoder state; IDLE between records, TYPE after 'S', or DIGITS of record bytes. */
+    enum : uint8_t {
+        IDLE,
+        TYPE,
+        DIGITS,
+    } _state;
+    /** Record type; Intel HEX type is known after its address. */
+    uint8_t _type;
+    bool _srec;
+    bool _low;
+    uint8_t _byte;
+    uint8_t _sum;
+    /** Index of the next byte in a record; 0 is length. */
+    uint16_t _pos;
+    /** Bytes of address, and index of the first data byte. */
+    uint8_t _addrLen;
+    uint8_t _dataPos;
+    uint8_t _dataLen;
+    uint32_t _address;
+    /** Extended address of Intel HEX, and start address. */
+    uint32_t _base;
+    uint32_t _start;
+    uint16_t _errors;
+    uint16_t _records;
+
+    void begin(bool srec, uint8_t addrLen, uint8_t type);
+    void decode(uint8_t b);
+    void dispatch();
+    void discard();
+    uint32_t dataValue() const;
+
+    /** No copy constructor. */
+    Loader(Loader const &) = delete;
+    /** No assignment operator. */
+    void operator=(Loader const &) = delete;
+};
+
+/** Loader which can receive up to |SIZE| bytes of data in a record. */
+template <size_t SIZE>
+class LoaderBuffer final : public Loader {
+    static_assert(SIZE <= UINT8_MAX, "SIZE is too large");
+
+public:
+    LoaderBuffer(RecordSink sink, uintptr_t context) : Loader(_storage, SIZE, sink, context) {}
+
+private:
+    uint8_t _storage[SIZE];
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
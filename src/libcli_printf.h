@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_PRINTF_H__
+#define __LIBCLI_PRINTF_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+#include "libcli_indices.h"
+
+namespace libcli {
+
+/**
+ * A format string compiled by LIBCLI_FORMAT, which takes |ARGS| arguments, and bit i of |STRS|
+ * is set if argument i is a string. |program| is in PROGMEM, where each conversion is replaced
+ * by an opcode, skip count and width.
+ */
+template <uint8_t ARGS, uint32_t STRS = 0>
+struct Format {
+    const /*PROGMEM*/ char *program;
+};
+
+namespace format {
+
+/** Opcodes of conversions, which must not appear in text. */
+enum Op : uint8_t {
+    OP_PERCENT = 1,  // %%
+    OP_DEC = 2,      // %d, signed decimal.
+    OP_UDEC = 3,     // %u
+    OP_HEX = 4,      // %x, 0-prefixed hexadecimal.
+    OP_OCT = 5,      // %o
+    OP_BIN = 6,      // %b
+    OP_STR = 7,      // %s
+    OP_CHAR = 8,     // %c
+    OP_END = 9,
+};
+
+/** An argument of |printFormat|. */
+struct Arg {
+    enum Type : uint8_t {
+        UNSIGNED,
+        SIGNED,
+        STR,
+        STR_P,
+    };
+
+    Arg() : type(UNSIGNED), u(0) {}
+    Arg(unsigned char v) : type(UNSIGNED), u(v) {}
+    Arg(unsigned short v) : type(UNSIGNED), u(v) {}
+    Arg(unsigned int v) : type(UNSIGNED), u(v) {}
+    Arg(unsigned long v) : type(UNSIGNED), u(v) {}
+    Arg(char v) : type(UNSIGNED), u(static_cast<uint8_t>(v)) {}
+    Arg(signed char v) : type(SIGNED), s(v) {}
+    Arg(short v) : type(SIGNED), s(v) {}
+    Arg(int v) : type(SIGNED), s(v) {}
+    Arg(long v) : type(SIGNED), s(v) {}
+    Arg(const char *v) : type(STR), str(v) {}
+    Arg(const __FlashStringHelper *v) : type(STR_P), str(reinterpret_cast<const char *>(v)) {}
+
+    Type type;
+    union {
+        uint32_t u;
+        int32_t s;
+        const char *str;
+    };
+};
+
+/**
+ * Errors in a format string. These are declared but not constexpr, so that reaching one while
+ * compiling a format is a compile error which names it, without exceptions.
+ */
+Op unknownConversion();
+bool controlCharInFormat();
+int tooWide();
+uint32_t tooManyArguments();
+
+constexpr bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr Op opOf(char c) {
+    return c == '%' ? OP_PERCENT
+         : c == 'd' ? OP_DEC
+         : c == 'u' ? OP_UDEC
+         : c == 'x' ? OP_HEX
+         : c == 'o' ? OP_OCT
+         : c == 'b' ? OP_BIN
+         : c == 's' ? OP_STR
+         : c == 'c' ? OP_CHAR
+                    : unknownConversion();
+}
+
+constexpr bool isText(char c) {
+    return static_cast<uint8_t>(c) >= OP_END || c == 0 ? true : controlCharInFormat();
+}
+
+/** Length of width digits at |i|. */
+constexpr size_t digitsAt(const char *text, size_t i) {
+    return isDigit(text[i]) ? 1 + digitsAt(text, i + 1) : 0;
+}
+
+constexpr int widthOf(const char *text, size_t i, int value = 0) {
+    return isDigit(text[i]) ? widthOf(text, i + 1, value * 10 + (text[i] - '0'))
+         : (value <= INT8_MAX ? value : tooWide());
+}
+
+/** Length of conversion which starts with '%' at |i|. */
+constexpr size_t specLength(const char *text, size_t i) {
+    return text[i + 1] == '-'
+                 ? 2 + digitsAt(text, i + 2) + (opOf(text[i + 2 + digitsAt(text, i + 2)]), 1)
+                 : 1 + digitsAt(text, i + 1) + (opOf(text[i + 1 + digitsAt(text, i + 1)]), 1);
+}
+
+/** Start of conversion which contains |i| searching from |j|, or |i| itself for text. */
+constexpr size_t specStart(const char *text, size_t i, size_t j = 0) {
+    return text[j] != '%' ? (j == i ? i : specStart(text, i, j + 1))
+         : (i < j + specLength(text, j) ? j : specStart(text, i, j + specLength(text, j)));
+}
+
+/** Compiled byte at |k| of conversion at |s|; opcode, skip count and width. */
+constexpr char specByte(const char *text, size_t s, size_t k) {
+    return k == 0 ? opOf(text[s + specLength(text, s) - 1])
+         : k == 1 ? static_cast<char>(specLength(text, s) - 1)
+         : k == 2 ? static_cast<char>(text[s + 1] == '-' ? -widthOf(text, s + 2)
+                                                          : widthOf(text, s + 1))
+                  : 0;
+}
+
+constexpr char compiled(const char *text, size_t size, size_t i) {
+    return i + 1 == size ? 0
+         : (specStart(text, i) == i && text[i] != '%')
+                 ? (isText(text[i]), text[i])
+                 : specByte(text, specStart(text, i), i - specStart(text, i));
+}
+
+/** Number of arguments which conversions take from |i|. */
+constexpr uint8_t count(const char *text, size_t i = 0) {
+    return text[i] == 0 ? 0
+         : text[i] != '%' ? count(text, i + 1)
+         : (opOf(text[i + specLength(text, i) - 1]) != OP_PERCENT) +
+                         count(text, i + specLength(text, i));
+}
+
+/** Bits of arguments which %s takes from |i|, where |n| arguments precede. */
+constexpr uint32_t strings(const char *text, size_t i = 0, uint8_t n = 0) {
+    return text[i] == 0 ? 0
+         : text[i] != '%' ? strings(text, i + 1, n)
+         : opOf(text[i + specLength(text, i) - 1]) == OP_PERCENT
+                 ? strings(text, i + specLength(text, i), n)
+         : n >= 32 ? tooManyArguments()
+                   : ((opOf(text[i + specLength(text, i) - 1]) == OP_STR ? uint32_t(1) << n : 0) |
+                             strings(text, i + specLength(text, i), n + 1));
+}
+
+/** True if |T| is an argument of %s. */
+template <typename T>
+struct IsStr {
+    static constexpr bool value = false;
+};
+template <>
+struct IsStr<const char *> {
+    static constexpr bool value = true;
+};
+template <>
+struct IsStr<char *> {
+    static constexpr bool value = true;
+};
+template <>
+struct IsStr<const __FlashStringHelper *> {
+    static constexpr bool value = true;
+};
+
+/** Bits of string arguments in |Args|, which should match |Format::STRS|. */
+template <typename... Args>
+struct Strings {
+    static constexpr uint32_t bits(uint8_t = 0) { return 0; }
+};
+template <typename T, typename... Args>
+struct Strings<T, Args...> {
+    static constexpr uint32_t bits(uint8_t n = 0) {
+        return (IsStr<T>::value ? uint32_t(1) << n : 0) | Strings<Args...>::bits(n + 1);
+    }
+};
+
+template <size_t N>
+struct Program {
+    char code[N];
+};
+
+template <size_t N, size_t... I>
+constexpr Program<N> compile(const char (&text)[N], Indices<I...>) {
+    return Program<N>{{compiled(text, N, I)...}};
+}
+
+}  // namespace format
+}  // namespace libcli
+
+/**
+ * Define libcli::Format |name| from string literal |text|, which is compiled into PROGMEM. A
+ * conversion is '%', optional '-' for left alignment, optional width and one of d (signed
+ * decimal), u (decimal), x (hexadecimal), o (octal), b (binary), s (string) or c (char); and
+ * "%%" is '%'. Newline is printed as CR and LF.
+ */
+#define LIBCLI_FORMAT(name, text)                                                         \
+    static constexpr auto name##_program_ PROGMEM = libcli::format::compile(              \
+            text, libcli::MakeIndices<sizeof(text)>::type());                             \
+    static constexpr libcli::Format<libcli::format::count(text),                          \
+            libcli::format::strings(text)>                                                \
+            name{name##_program_.code}
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_RING_H__
+#define __LIBCLI_RING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libcli {
+
+/**
+ * Single-producer single-consumer lock-free byte ring. |put| may be called from an interrupt
+ * handler or a DMA completion while Cli consumes bytes from |loop|. One byte is kept empty to
+ * distinguish full from empty, so the capacity is one less than the size.
+ */
+class Ring {
+public:
+#if defined(__AVR__)
+    /** 8-bit index so that the other side reads it atomically. */
+    using Index = uint8_t;
+#else
+    using Index = uint16_t;
+#endif
+
+    /** Producer; returns false and counts overflow when the ring is full. */
+    bool put(uint8_t c) {
+        const Index head = _head;
+        const Index next = (head + 1) & _mask;
+        if (next == _tail) {
+            _overflow = _overflow + 1;
+            return false;
+        }
+        _buffer[head] = c;
+        barrier();
+        _head = next;
+        return true;
+    }
+
+    /** Producer; returns the number of bytes put, the rest are counted as overflow. */
+    size_t put(const uint8_t *buf, size_t size) {
+        size_t n = 0;
+        while (n < size && put(buf[n]))
+            n++;
+        if (n < size)
+            _overflow = _overflow + (size - n - 1);  // |put| counted one
+        return n;
+    }
+
+    /** Consumer; number of bytes in the ring. */
+    int available() const { return (_head - _tail) & _mask; }
+
+    /** Consumer; next byte, or -1 if empty. */
+    int peek() const { return available() ? _buffer[_tail] : -1; }
+
+    /** Consumer; read next byte, or -1 if empty. */
+    int read() {
+        const Index tail = _tail;
+        if (tail == _head)
+            return -1;
+        const uint8_t c = _buffer[tail];
+        barrier();
+        _tail = (tail + 1) & _mask;
+        return c;
+    }
+
+    /** Number of bytes which couldn't be put because the ring was full. */
+    uint32_t overflow() const {
+        uint32_t n;
+        do {  // may be updated by producer while reading non-atomically.
+            n = _overflow;
+        } while (n != _overflow);
+        return n;
+    }
+
+    /** Consumer; discard all bytes and clear overflow count. */
+    void clear() {
+        _tail = _head;
+        _overflow = 0;
+    }
+
+protected:
+    Ring(uint8_t *buffer, Index mask)
+        : _buffer(buffer), _mask(mask), _head(0), _tail(0), _overflow(0) {}
+
+private:
+    uint8_t *const _buffer;
+    const Index _mask;
+    volatile Index _head;
+    volatile Index _tail;
+    volatile uint32_t _overflow;
+
+    /** Keep compiler from reordering accesses to buffer and index. */
+    static void barrier() { asm volatile("" ::: "memory"); }
+
+    /** No copy constructor. */
+    Ring(Ring const &) = delete;
+    /** No assignment operator. */
+    void operator=(Ring const &) = delete;
+};
+
+/** Ring with |SIZE| bytes of storage, which must be a power of 2. */
+template <size_t SIZE>
+class RingBuffer final : public Ring {
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of 2");
+    static_assert(SIZE - 1 <= Index(~0), "SIZE is too large for Index");
+
+public:
+    RingBuffer() : Ring(_storage, SIZE - 1) {}
+
+private:
+    uint8_t _storage[SIZE];
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_STATS_H__
+#define __LIBCLI_STATS_H__
+
+#include <stdint.h>
+
+#include "libcli_types.h"
+
+namespace libcli {
+
+/**
+ * Coarse histogram of latency in micro seconds. Bin 0 counts 0us, and bin |i| counts from
+ * 4^(i-1) to 4^i-1 us, except the last bin which counts everything above.
+ */
+struct Histogram {
+    static constexpr uint8_t BINS = 8;
+
+    uint32_t count[BINS];
+    uint32_t max;
+
+    /** Lower bound of |bin| in micro seconds. */
+    static constexpr uint32_t lower(uint8_t bin) { return bin ? 1UL << (2 * (bin - 1)) : 0; }
+
+    void add(uint32_t us) {
+        if (max < us)
+            max = us;
+        uint8_t bin = 0;
+        for (auto n = us; n && bin < BINS - 1; n >>= 2)
+            bin++;
+        count[bin]++;
+    }
+};
+
+/**
+ * Instrumentation counters, which are available when LIBCLI_STATS is defined. It adds these
+ * to Cli, so that it must be defined for the library and all sketch files alike, otherwise
+ * they disagree on the layout of Cli.
+ */
+struct Stats {
+    /** Bytes read from console. */
+    uint32_t bytesIn;
+    /** Bytes written to console, including echo back. */
+    uint32_t bytesOut;
+    /** Characters ignored because of buffer overflow, limit or invalid digit. */
+    uint32_t dropped;
+    /** Invocations of LetterCallback. */
+    uint32_t letters;
+    /** Invocations of other callbacks, indexed by State. */
+    uint32_t states[CLI_CONTINUE + 1];
+    /** Latency of |loop| which processed input. */
+    Histogram loops;
+    /** Latency of callbacks. */
+    Histogram callbacks;
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_STR_H__
+#define __LIBCLI_STR_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+namespace libcli {
+
+/**
+ * A string in PROGMEM with its length, which is defined by LIBCLI_STR. Its length is known
+ * without scanning the text, so that padded printing reads the text just once.
+ */
+struct Str {
+    constexpr Str(uint8_t len, const /*PROGMEM*/ char *text_P) : _len(len), _text_P(text_P) {}
+
+    uint8_t length() const { return pgm_read_byte(&_len); }
+    const /*PROGMEM*/ char *text_P() const {
+        return static_cast<const char *>(pgm_read_ptr(&_text_P));
+    }
+
+    /** Entry at |index| of a PROGMEM table of Str pointers. */
+    static const Str &at(const /*PROGMEM*/ Str *const *table, size_t index) {
+        return *static_cast<const Str *>(pgm_read_ptr(&table[index]));
+    }
+
+private:
+    const uint8_t _len;
+    const /*PROGMEM*/ char *const _text_P;
+};
+
+}  // namespace libcli
+
+/**
+ * Define libcli::Str |name| of string literal |text| in PROGMEM. Refer the same |name| to share
+ * a text among tables and labels.
+ */
+#define LIBCLI_STR(name, text)                                                        \
+    static_assert(sizeof(text) <= UINT8_MAX + 1, "too long text");                    \
+    static constexpr char name##_text_[] PROGMEM = text;                              \
+    static constexpr libcli::Str name PROGMEM = {sizeof(text) - 1, name##_text_}
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_TOKENS_H__
+#define __LIBCLI_TOKENS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+namespace libcli {
+
+/** A view of a token in a line buffer, which is also NUL terminated. */
+struct Token {
+    const char *text;
+    size_t len;
+};
+
+/**
+ * Split a line, such as the buffer of |readLine|, into tokens in place. Tokens are separated
+ * by spaces, and a token may be quoted by '"' or '\'' to contain spaces, where '\\' escapes the
+ * next char. Separators and quotes are overwritten, so no copy is made.
+ */
+class Tokenizer {
+public:
+    /** Returns the number of tokens, or -1 for too many tokens or an unterminated quote. */
+    int split(char *line);
+
+    /** The number of tokens. */
+    size_t size() const { return _count; }
+
+    /** Token at |index|, which must be less than |size|. */
+    const Token &operator[](size_t index) const { return _tokens[index]; }
+
+    /**
+     * Parse token at |index| as a number less or equal to |limit| in |radix| into |value|.
+     * Returns false if there is no such token, it has an invalid digit or exceeds |limit|.
+     */
+    bool hex(size_t index, uint32_t &value, uint32_t limit = UINT32_MAX) const {
+        return num(index, 16, value, limit);
+    }
+    bool dec(size_t index, uint32_t &value, uint32_t limit = UINT32_MAX) const {
+        return num(index, 10, value, limit);
+    }
+    bool num(size_t index, uint_fast8_t radix, uint32_t &value, uint32_t limit = UINT32_MAX) const;
+    bool num(size_t index, uint_fast8_t radix, uint64_t &value, uint64_t limit = UINT64_MAX) const;
+
+    /**
+     * Parse token at |index| as a decimal number with optional '-' sign between |min| and |max|.
+     */
+    bool dec(size_t index, int32_t &value, int32_t min = INT32_MIN, int32_t max = INT32_MAX) const;
+
+    /**
+     * Returns the position of token at |index| in |keywords| separated by '|', such as
+     * F("get|set|reset"), or -1 if not found.
+     */
+    int keyword(size_t index, const __FlashStringHelper *keywords) const;
+
+protected:
+    Tokenizer(Token *tokens, size_t capacity) : _tokens(tokens), _capacity(capacity), _count(0) {}
+
+private:
+    Token *const _tokens;
+    const size_t _capacity;
+    size_t _count;
+
+    /** No copy constructor. */
+    Tokenizer(Tokenizer const &) = delete;
+    /** No assignment operator. */
+    void operator=(Tokenizer const &) = delete;
+};
+
+/** Tokenizer which can hold up to |N| tokens. */
+template <size_t N>
+class Tokens final : public Tokenizer {
+public:
+    Tokens() : Tokenizer(_storage, N) {}
+
+private:
+    Token _storage[N];
+};
+
+}  // namespace libcli
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
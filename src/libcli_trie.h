@@ -0,0 +1,148 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIBCLI_TRIE_H__
+#define __LIBCLI_TRIE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+#include "libcli_indices.h"
+
+namespace libcli {
+
+/**
+ * A node of prefix trie. Nodes are in preorder, so that the first child of a node is the next
+ * node whose |depth| is one deeper.
+ */
+struct TrieNode {
+    /** |depth| has this flag when a word ends at this node. */
+    static constexpr uint8_t TERMINAL = 0x80;
+    static constexpr uint8_t DEPTH = 0x7F;
+
+    char letter;
+    uint8_t depth;
+    uint8_t sibling;
+};
+
+/** Prefix trie of words for completion, which is placed in PROGMEM. */
+struct Trie {
+    const /*PROGMEM*/ TrieNode *nodes;
+    uint8_t size;
+};
+
+namespace trie {
+
+/** No sibling. */
+constexpr uint8_t NONE = UINT8_MAX;
+
+constexpr size_t length(const char *s, size_t i = 0) {
+    return s[i] ? length(s, i + 1) : i;
+}
+
+/** Length of common prefix of |a| and |b|. */
+constexpr size_t common(const char *a, const char *b, size_t i = 0) {
+    return (a[i] && a[i] == b[i]) ? common(a, b, i + 1) : i;
+}
+
+constexpr bool less(const char *a, const char *b) {
+    return *a != *b ? static_cast<uint8_t>(*a) < static_cast<uint8_t>(*b)
+                    : (*a && less(a + 1, b + 1));
+}
+
+constexpr bool sorted(const char *const *w, size_t n, size_t i = 1) {
+    return i >= n || (less(w[i - 1], w[i]) && sorted(w, n, i + 1));
+}
+
+/** Depth of the first node of word |k|, which is shared with the previous word. */
+constexpr size_t prefix(const char *const *w, size_t k) {
+    return k == 0 ? 0 : common(w[k - 1], w[k]);
+}
+
+/** Number of nodes which word |k| adds. */
+constexpr size_t run(const char *const *w, size_t k) {
+    return length(w[k]) - prefix(w, k);
+}
+
+constexpr size_t count(const char *const *w, size_t n, size_t k = 0) {
+    return k >= n ? 0 : run(w, k) + count(w, n, k + 1);
+}
+
+constexpr size_t startOf(const char *const *w, size_t k) {
+    return k == 0 ? 0 : startOf(w, k - 1) + run(w, k - 1);
+}
+
+/** Word which adds node |i|. */
+constexpr size_t wordOf(const char *const *w, size_t i, size_t k = 0) {
+    return i < startOf(w, k) + run(w, k) ? k : wordOf(w, i, k + 1);
+}
+
+constexpr size_t depthOf(const char *const *w, size_t i) {
+    return prefix(w, wordOf(w, i)) + i - startOf(w, wordOf(w, i));
+}
+
+/** Next sibling of node at |depth| searching from word |m|. */
+constexpr uint8_t siblingOf(const char *const *w, size_t n, size_t depth, size_t m) {
+    return m >= n ? NONE
+         : prefix(w, m) > depth ? siblingOf(w, n, depth, m + 1)
+         : prefix(w, m) == depth ? startOf(w, m)
+                                 : NONE;
+}
+
+constexpr TrieNode node(const char *const *w, size_t n, size_t i) {
+    return TrieNode{w[wordOf(w, i)][depthOf(w, i)],
+            static_cast<uint8_t>(depthOf(w, i) |
+                                 (depthOf(w, i) + 1 == length(w[wordOf(w, i)]) ? TrieNode::TERMINAL
+                                                                                : 0)),
+            siblingOf(w, n, depthOf(w, i), wordOf(w, i) + 1)};
+}
+
+template <size_t N>
+struct Nodes {
+    TrieNode node[N];
+};
+
+template <size_t... I>
+constexpr Nodes<sizeof...(I)> makeNodes(const char *const *w, size_t n, Indices<I...>) {
+    return Nodes<sizeof...(I)>{{node(w, n, I)...}};
+}
+
+}  // namespace trie
+}  // namespace libcli
+
+/**
+ * Define Trie |name| in PROGMEM from constexpr array of strings |words|, which must be sorted
+ * and unique. The array itself is used only at compile time.
+ */
+#define LIBCLI_TRIE(name, words)                                                            \
+    static constexpr size_t name##_words_ = sizeof(words) / sizeof(words[0]);               \
+    static_assert(libcli::trie::sorted(words, name##_words_), "words must be sorted");      \
+    static constexpr size_t name##_size_ = libcli::trie::count(words, name##_words_);       \
+    static_assert(name##_size_ < libcli::trie::NONE, "too many trie nodes");                \
+    static constexpr auto name##_nodes_ PROGMEM = libcli::trie::makeNodes(words,            \
+            name##_words_, libcli::MakeIndices<name##_size_>::type());                      \
+    static constexpr libcli::Trie name PROGMEM = {name##_nodes_.node, name##_size_}
+
+#endif
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -29,8 +29,22 @@ enum State : uint8_t {
     CLI_NEWLINE,  // an input is terminated by newline.
     CLI_DELETE,   // current input is canceled and back to previous.
     CLI_CANCEL,   // whole input is canceled.
+    CLI_CONTINUE, // a chunk of |readChunks| is full and the line continues.
 };
 
+/** What |loop| did; CLI_IDLE, or a bit set of CLI_CONSUMED and CLI_PENDING. */
+enum LoopStatus : uint8_t {
+    CLI_IDLE = 0,      // no input is consumed nor waiting, and output is drained.
+    CLI_CONSUMED = 1,  // some input is consumed.
+    CLI_PENDING = 2,   // input is available or output is waiting to be sent.
+};
+
+/** Hook function which is called by |loop| when idle. */
+using IdleHook = void (*)(uintptr_t context);
+
+/** Max fraction digits of a fixed-point number, which is scaled into int32_t. */
+constexpr uint8_t FIXED_FRACTION_MAX = 9;
+
 /** Callback function of |readLetter|. */
 using LetterCallback = void (*)(char letter, uintptr_t context);
 
@@ -40,6 +54,64 @@ using StringCallback = void (*)(char *string, uintptr_t context, State state);
 /** Callback function of |readHex| and |readDec|. */
 using NumberCallback = void (*)(uint32_t number, uintptr_t context, State state);
 
+/** Callback function of 64-bit |readHex|, |readDec| and |readNum|. */
+using Number64Callback = void (*)(uint64_t number, uintptr_t context, State state);
+
+/** Callback function of signed |readDec| and |readNum|. */
+using SignedCallback = void (*)(int32_t number, uintptr_t context, State state);
+
+/** Callback function of 64-bit signed |readDec| and |readNum|. */
+using Signed64Callback = void (*)(int64_t number, uintptr_t context, State state);
+
+/** Callback function of |printDump| to read a byte at |address|. */
+using DumpReader = uint8_t (*)(uint32_t address, uintptr_t context);
+
+/**
+ * Adapters which turn a member function |M| of |T| into a plain callback whose |context| is
+ * the object, such as Member<App>::call<&App::onNumber> for void App::onNumber(uint32_t, State).
+ * The member function is resolved at compile time, so it can be inlined into the adapter.
+ */
+template <typename T>
+struct Member {
+    static uintptr_t context(T &object) { return reinterpret_cast<uintptr_t>(&object); }
+
+    template <void (T::*M)(char)>
+    static void call(char letter, uintptr_t context) {
+        (of(context)->*M)(letter);
+    }
+    template <void (T::*M)(char *, State)>
+    static void call(char *string, uintptr_t context, State state) {
+        (of(context)->*M)(string, state);
+    }
+    template <void (T::*M)(const char *, State)>
+    static void call(const char *name, uintptr_t context, State state) {
+        (of(context)->*M)(name, state);
+    }
+    template <void (T::*M)(uint32_t, State)>
+    static void call(uint32_t number, uintptr_t context, State state) {
+        (of(context)->*M)(number, state);
+    }
+    template <void (T::*M)(uint64_t, State)>
+    static void call(uint64_t number, uintptr_t context, State state) {
+        (of(context)->*M)(number, state);
+    }
+    template <void (T::*M)(int32_t, State)>
+    static void call(int32_t number, uintptr_t context, State state) {
+        (of(context)->*M)(number, state);
+    }
+    template <void (T::*M)(int64_t, State)>
+    static void call(int64_t number, uintptr_t context, State state) {
+        (of(context)->*M)(number, state);
+    }
+    template <uint8_t (T::*M)(uint32_t)>
+    static uint8_t call(uint32_t address, uintptr_t context) {
+        return (of(context)->*M)(address);
+    }
+
+private:
+    static T *of(uintptr_t context) { return reinterpret_cast<T *>(context); }
+};
+
 }  // namespace libcli
 
 #endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+
+#include <Arduino.h>
+
+#include <libcli.h>
+#include <libcli/fake/BenchStream.h>
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using BenchStream = libcli::fake::BenchStream;
+using libcli::fake::benchReport;
+
+constexpr uint32_t COUNT = 1000000;
+
+BenchStream stream;
+Cli cli;
+char buffer[40];
+
+void handleLetter(char, uintptr_t) {
+    cli.readLetter(handleLetter, 0);
+}
+
+void handleWord(char *, uintptr_t, State) {
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+}
+
+void handleLine(char *, uintptr_t, State) {
+    cli.readLine(handleLine, 0, buffer, sizeof(buffer));
+}
+
+void handleHex(uint32_t, uintptr_t, State) {
+    cli.readHex(handleHex, 0, UINT32_MAX);
+}
+
+void handleDec(uint32_t, uintptr_t, State) {
+    cli.readDec(handleDec, 0, UINT32_MAX);
+}
+
+void handleDec64(uint64_t, uintptr_t, State) {
+    cli.readDec(handleDec64, 0, UINT64_MAX);
+}
+
+void handleSigned(int32_t, uintptr_t, State) {
+    cli.readDec(handleSigned, 0, INT32_MIN, INT32_MAX);
+}
+
+/**
+ * Feed COUNT characters of |text| through Cli::loop() after |arm| requests the first input.
+ * |batch| zero calls loop() for each character, otherwise loop(batch).
+ */
+void bench(const char *name, const char *text, void (*arm)(), size_t batch) {
+    char params[40];
+    snprintf(params, sizeof(params), "batch=%u", (unsigned)batch);
+    stream.setInput(text, COUNT);
+    stream.resetWritten();
+    arm();
+    const auto start = micros();
+    uint32_t chars = 0;
+    if (batch) {
+        while (stream.available())
+            chars += cli.loop(batch);
+    } else {
+        while (stream.available()) {
+            cli.loop();
+            chars++;
+        }
+    }
+    benchReport(name, params, chars, micros() - start, stream.written());
+}
+
+void setup() {
+    cli.begin(stream);
+}
+
+void loop() {
+    const size_t batches[] = {0, 64};
+    for (auto batch : batches) {
+        bench("readLetter", "abcdefgh", [] { handleLetter(0, 0); }, batch);
+        bench("readWord", "abcdefg ", [] { handleWord(nullptr, 0, State::CLI_SPACE); }, batch);
+        bench("readLine", "hello world 0123\n",
+                [] { handleLine(nullptr, 0, State::CLI_NEWLINE); }, batch);
+        bench("readHex", "DEADBEEF ", [] { handleHex(0, 0, State::CLI_SPACE); }, batch);
+        bench("readDec", "123456789 ", [] { handleDec(0, 0, State::CLI_SPACE); }, batch);
+        bench("readDec64", "12345678901234567890 ",
+                [] { handleDec64(0, 0, State::CLI_SPACE); }, batch);
+        bench("readSigned", "-123456789 ", [] { handleSigned(0, 0, State::CLI_SPACE); },
+                batch);
+    }
+    exit(0);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
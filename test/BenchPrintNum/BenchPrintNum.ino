@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Arduino.h>
+
+#include <libcli.h>
+#include <libcli/fake/BenchStream.h>
+
+using Cli = libcli::Cli;
+using BenchStream = libcli::fake::BenchStream;
+using libcli::fake::benchReport;
+
+/** The former implementation; count digits by division then print(number, radix). */
+size_t legacyPrintNum(Print &out, uint32_t number, int_fast8_t width, uint_fast8_t radix) {
+    int_fast8_t len = 0;
+    auto n = number;
+    do {
+        len++;
+        n /= radix;
+    } while (n);
+    size_t size = 0;
+    const char pad = radix == 10 ? ' ' : '0';
+    for (auto i = width - len; i > 0; i--)
+        size += out.print(pad);
+    size += out.print(number, radix);
+    for (auto i = width + len; i < 0; i++)
+        size += out.print(' ');
+    return size;
+}
+
+constexpr uint32_t COUNT = 200000;
+
+uint32_t sample(uint32_t i) {
+    // xorshift to spread numbers over the whole range.
+    i ^= i << 13;
+    i ^= i >> 17;
+    i ^= i << 5;
+    return i;
+}
+
+void bench(uint_fast8_t radix, int_fast8_t width) {
+    char params[40];
+    snprintf(params, sizeof(params), "radix=%d width=%d", radix, width);
+
+    BenchStream legacy;
+    auto start = micros();
+    for (uint32_t i = 1; i <= COUNT; i++)
+        legacyPrintNum(legacy, sample(i), width, radix);
+    benchReport("legacyPrintNum", params, COUNT, micros() - start, legacy.written());
+
+    BenchStream stream;
+    Cli cli;
+    cli.begin(stream);
+    start = micros();
+    for (uint32_t i = 1; i <= COUNT; i++)
+        cli.printNum(sample(i), radix, width);
+    benchReport("printNum", params, COUNT, micros() - start, stream.written());
+
+    if (legacy.written() != stream.written()) {
+        printf("error=output_mismatch %s\n", params);
+        exit(1);
+    }
+}
+
+void setup() {}
+
+void loop() {
+    const uint8_t radixes[] = {16, 10, 8, 2};
+    const int8_t widths[] = {0, 12, -12};
+    for (auto radix : radixes) {
+        for (auto width : widths)
+            bench(radix, width);
+    }
+    exit(0);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+
+#define NL "\r\n"
+#define BS "\b \b"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 10) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+struct Result {
+    char name[20];
+    int handler = 0;
+    uintptr_t context;
+    State state;
+    void set(int h, const char *n, uintptr_t c, State s) {
+        handler = h;
+        strcpy(name, n);
+        context = c;
+        state = s;
+    }
+} result;
+
+void handler1(const char *name, uintptr_t context, State state) {
+    result.set(1, name, context, state);
+}
+
+void handler2(const char *name, uintptr_t context, State state) {
+    result.set(2, name, context, state);
+}
+
+void handler3(const char *name, uintptr_t context, State state) {
+    result.set(3, name, context, state);
+}
+
+void unknown(const char *name, uintptr_t context, State state) {
+    result.set(-1, name, context, state);
+}
+
+static constexpr libcli::Command LETTERS[] PROGMEM = {
+        {"a", handler1},
+        {"b", handler2},
+        {"?", handler3},
+        {"", unknown},
+};
+LIBCLI_COMMAND_TABLE(letters, LETTERS);
+
+static constexpr libcli::Command WORDS[] PROGMEM = {
+        {"step", handler1},
+        {"load", handler2},
+        {"dump", handler3},
+};
+LIBCLI_COMMAND_TABLE(words, WORDS);
+
+static constexpr libcli::Command MANY[] PROGMEM = {
+        {"a", handler1},
+        {"b", handler1},
+        {"c", handler1},
+        {"d", handler1},
+        {"e", handler1},
+        {"f", handler1},
+        {"g", handler1},
+        {"h", handler1},
+        {"i", handler1},
+        {"j", handler1},
+        {"k", handler1},
+        {"l", handler1},
+        {"m", handler1},
+        {"n", handler1},
+        {"o", handler1},
+        {"p", handler1},
+        {"q", handler1},
+        {"r", handler1},
+        {"s", handler1},
+        {"t", handler1},
+        {"u", handler1},
+        {"v", handler1},
+        {"w", handler1},
+        {"x", handler1},
+        {"y", handler1},
+        {"z", handler2},
+        {"help", handler3},
+        {"version", handler3},
+        {"dump", handler1},
+        {"load", handler1},
+        {"run", handler1},
+        {"step", handler1},
+        {"reset", handler1},
+        {"go", handler1},
+        {"set", handler1},
+        {"get", handler1},
+        {"info", handler1},
+        {"list", handler1},
+        {"echo", handler1},
+        {"quit", handler2},
+};
+static_assert(sizeof(MANY) / sizeof(MANY[0]) == libcli::COMMAND_TABLE_MAX, "not full");
+LIBCLI_COMMAND_TABLE(many, MANY);
+
+test(CommandTest, letter) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    result.handler = 0;
+    cli.readLetter(letters, 10);
+    stream.setInput('b');
+    inject(cli);
+    assertEqual(result.handler, 2);
+    assertEqual(result.name, "b");
+    assertEqual(result.context, (uintptr_t)10);
+    assertEqual(result.state, State::CLI_SPACE);
+    assertEqual(stream.printerText(), "");
+
+    cli.readLetter(letters, 20);
+    stream.setInput('?');
+    inject(cli);
+    assertEqual(result.handler, 3);
+    assertEqual(result.name, "?");
+    assertEqual(result.context, (uintptr_t)20);
+}
+
+test(CommandTest, letter_unknown) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    result.handler = 0;
+    cli.readLetter(letters, 0);
+    stream.setInput('x');
+    inject(cli);
+    assertEqual(result.handler, -1);
+    assertEqual(result.name, "x");
+    assertEqual(result.state, State::CLI_SPACE);
+
+    result.handler = 0;
+    cli.readLetter(words, 0);  // no fallback
+    stream.setInput("xs");
+    inject(cli);
+    assertEqual(result.handler, 0);
+}
+
+test(CommandTest, word) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[10];
+    result.handler = 0;
+    cli.readWord(words, 30, buffer, sizeof(buffer));
+    stream.setInput("load ");
+    inject(cli);
+    assertEqual(stream.printerText(), "load ");
+    assertEqual(result.handler, 2);
+    assertEqual(result.name, "load");
+    assertEqual(result.context, (uintptr_t)30);
+    assertEqual(result.state, State::CLI_SPACE);
+
+    cli.readWord(words, 40, buffer, sizeof(buffer));
+    stream.setInput("dump\n");
+    inject(cli);
+    assertEqual(result.handler, 3);
+    assertEqual(result.name, "dump");
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
+test(CommandTest, word_unknown) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[10];
+    result.handler = 0;
+    cli.readWord(words, 0, buffer, sizeof(buffer));
+    stream.setInput("stop ");
+    inject(cli);
+    assertEqual(stream.printerText(), "stop " BS BS BS BS BS);  // erased
+    assertEqual(result.handler, 0);
+
+    stream.flush();
+    stream.setInput("step\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "step ");
+    assertEqual(result.handler, 1);
+    assertEqual(result.name, "step");
+}
+
+test(CommandTest, word_cancel) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[10];
+    result.handler = 0;
+    cli.readWord(letters, 0, buffer, sizeof(buffer));
+    stream.setInput("ab\x03");
+    inject(cli);
+    assertEqual(stream.printerText(), "ab cancel" NL);
+    assertEqual(result.handler, -1);
+    assertEqual(result.state, State::CLI_CANCEL);
+
+    result.handler = 0;
+    cli.readWord(letters, 0, buffer, sizeof(buffer));
+    stream.setInput('\b');
+    inject(cli);
+    assertEqual(result.handler, -1);
+    assertEqual(result.state, State::CLI_DELETE);
+}
+
+test(CommandTest, many) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[10];
+    for (char c = 'a'; c <= 'z'; c++) {
+        result.handler = 0;
+        cli.readLetter(many, 0);
+        stream.setInput(c);
+        inject(cli);
+        assertEqual(result.handler, c == 'z' ? 2 : 1);
+        assertEqual(result.name[0], c);
+    }
+    result.handler = 0;
+    cli.readWord(many, 0, buffer, sizeof(buffer));
+    stream.setInput("version ");
+    inject(cli);
+    assertEqual(result.handler, 3);
+    assertEqual(result.name, "version");
+
+    result.handler = 0;
+    cli.readWord(many, 0, buffer, sizeof(buffer));
+    stream.setInput("quit ");
+    inject(cli);
+    assertEqual(result.handler, 2);
+    assertEqual(result.name, "quit");
+}
+
+struct Monitor {
+    int steps = 0;
+    char last[10] = "";
+    void step(const char *name, State) {
+        steps++;
+        strcpy(last, name);
+    }
+    void load(const char *name, State) { strcpy(last, name); }
+};
+
+static constexpr libcli::Command MONITOR[] PROGMEM = {
+        {"step", Cli::Member<Monitor>::call<&Monitor::step>},
+        {"load", Cli::Member<Monitor>::call<&Monitor::load>},
+};
+LIBCLI_COMMAND_TABLE(monitor, MONITOR);
+
+test(CommandTest, member) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Monitor mon;
+    char buffer[10];
+    cli.readWord(monitor, Cli::Member<Monitor>::context(mon), buffer, sizeof(buffer));
+    stream.setInput("step ");
+    inject(cli);
+    assertEqual(mon.steps, 1);
+    assertEqual(mon.last, "step");
+
+    cli.readWord(monitor, Cli::Member<Monitor>::context(mon), buffer, sizeof(buffer));
+    stream.setInput("load ");
+    inject(cli);
+    assertEqual(mon.steps, 1);
+    assertEqual(mon.last, "load");
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -61,6 +61,20 @@ test(printTest, writeText) {
     assertEqual(stream.printerText(), "");
 }
 
+test(printTest, overflow) {
+    libcli::fake::FakeStreamBuffer<4, 8> stream;
+
+    assertEqual((int)stream.write((const uint8_t *)"abcde", 5), 5);
+    assertEqual((int)stream.write((const uint8_t *)"fghij", 5), 3);
+    assertEqual((int)stream.write('k'), 0);
+    assertEqual(stream.printerLength(), 8);
+    assertEqual(stream.printerText(), "abcdefgh");
+
+    stream.flush();
+    assertEqual((int)stream.write('x'), 1);
+    assertEqual(stream.printerText(), "x");
+}
+
 test(streamTest, empty) {
     FakeStream stream;
 
@@ -152,6 +166,34 @@ test(streamTest, text_F) {
     assertEqual(stream.read(), -1);
 }
 
+test(streamTest, large) {
+    static libcli::fake::FakeStreamBuffer<100000, 4> stream;
+    static char text[100000 + 1];
+
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = 'a' + i % 26;
+    text[sizeof(text) - 1] = 0;
+    stream.setInput(text);
+    assertEqual(stream.available(), INT16_MAX);
+    uint32_t n = 0;
+    while (stream.available() && stream.read() == int('a' + n % 26))
+        n++;
+    assertEqual(n, (uint32_t)100000);
+    assertEqual(stream.read(), -1);
+
+    // Input is truncated to the arena.
+    stream.setInput("");
+    assertEqual(stream.available(), 0);
+    static char more[100010 + 1];
+    memset(more, 'x', sizeof(more) - 1);
+    stream.setInput(more);
+    assertEqual(stream.available(), INT16_MAX);
+    n = 0;
+    while (stream.read() >= 0)
+        n++;
+    assertEqual(n, (uint32_t)100000);
+}
+
 void setup() {}
 
 void loop() {
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+
+#define NL "\r\n"
+#define BS "\b \b"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 20) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+static constexpr libcli::Field FIELDS[] PROGMEM = {
+        libcli::field::hex(0xFFF),
+        libcli::field::dec(99, 16),
+        libcli::field::signedDec(-9, 9, -1),
+};
+
+struct Record {
+    int calls = 0;
+    size_t count;
+    uint32_t values[3];
+    State state;
+} record;
+
+void handleForm(const Cli::Form &form, uintptr_t context, State state) {
+    auto &r = *reinterpret_cast<Record *>(context);
+    r.calls++;
+    r.count = form.count();
+    for (size_t i = 0; i < form.size(); i++)
+        r.values[i] = form.value(i);
+    r.state = state;
+}
+
+test(FormTest, complete) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    record = Record();
+    libcli::FormBuffer<3> form(FIELDS, handleForm, reinterpret_cast<uintptr_t>(&record));
+
+    cli.readForm(form);
+    stream.setInput("1a 20 -5 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "1a" BS BS "01A 20" BS BS "20 -5" BS BS "-5 ");
+    assertEqual(record.calls, 1);
+    assertEqual(record.count, (size_t)3);
+    assertEqual(record.values[0], (uint32_t)0x1A);
+    assertEqual(record.values[1], (uint32_t)20);
+    assertEqual(form.signedValue(2), (int32_t)-5);
+    assertEqual(record.state, State::CLI_SPACE);
+}
+
+test(FormTest, defaults) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    record = Record();
+    libcli::FormBuffer<3> form(FIELDS, handleForm, reinterpret_cast<uintptr_t>(&record));
+
+    cli.readForm(form);
+    stream.setInput("123\r");
+    inject(cli);
+    assertEqual(record.calls, 1);
+    assertEqual(record.count, (size_t)1);
+    assertEqual(record.values[0], (uint32_t)0x123);
+    assertEqual(record.values[1], (uint32_t)16);
+    assertEqual(form.signedValue(2), (int32_t)-1);
+    assertEqual(record.state, State::CLI_NEWLINE);
+}
+
+test(FormTest, delete_back) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    record = Record();
+    libcli::FormBuffer<3> form(FIELDS, handleForm, reinterpret_cast<uintptr_t>(&record));
+
+    cli.readForm(form);
+    stream.setInput("\b1 2\b\b");
+    inject(cli);
+    assertEqual(record.calls, 0);
+    assertEqual(stream.printerText(), "1" BS "001 2" BS BS BS BS BS "001");
+    stream.flush();
+
+    // Back in the first field with its value.
+    stream.setInput("\b4\r");
+    inject(cli);
+    assertEqual(record.calls, 1);
+    assertEqual(record.count, (size_t)1);
+    assertEqual(record.values[0], (uint32_t)0x4);
+    assertEqual(record.values[1], (uint32_t)16);
+}
+
+test(FormTest, cancel) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    record = Record();
+    libcli::FormBuffer<3> form(FIELDS, handleForm, reinterpret_cast<uintptr_t>(&record));
+
+    cli.readForm(form);
+    stream.setInput("1 2\x03");
+    inject(cli);
+    assertEqual(record.calls, 1);
+    assertEqual(record.state, State::CLI_CANCEL);
+}
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+using Frame = libcli::Frame;
+
+void inject(Cli &cli, int n = 40) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+struct Result {
+    int calls;
+    uint8_t id;
+    uint8_t size;
+    uint16_t u16;
+    uint32_t u32;
+    int32_t s32;
+    uintptr_t context;
+} result;
+
+void handleSet(const Frame &frame, uintptr_t context) {
+    result.calls++;
+    result.id = frame.id;
+    result.size = frame.size;
+    result.u16 = frame.u16(0);
+    result.u32 = frame.u32(2);
+    result.s32 = frame.s32(6);
+    result.context = context;
+}
+
+void handleAny(const Frame &frame, uintptr_t context) {
+    result.calls++;
+    result.id = frame.id;
+    result.size = frame.size;
+    result.context = context;
+}
+
+static constexpr libcli::FrameCommand COMMANDS[] PROGMEM = {
+        {0x10, 10, handleSet},
+        {0x20, libcli::FrameCommand::ANY_SIZE, handleAny},
+};
+
+/** Build a frame of |id| and |size| bytes of |data| into |buf|; returns its length. */
+size_t frame(uint8_t *buf, uint8_t id, const uint8_t *data, uint8_t size) {
+    auto p = buf;
+    *p++ = Frame::STX;
+    *p++ = size;
+    *p++ = id;
+    auto crc = Frame::crc16(Frame::crc16(Frame::CRC_INIT, size), id);
+    for (uint8_t i = 0; i < size; i++) {
+        *p++ = data[i];
+        crc = Frame::crc16(crc, data[i]);
+    }
+    *p++ = crc >> 8;
+    *p++ = crc;
+    return p - buf;
+}
+
+void put(libcli::Ring &ring, const char *text) {
+    ring.put(reinterpret_cast<const uint8_t *>(text), strlen(text));
+}
+
+char word[20];
+
+void handleWord(char *string, uintptr_t, State) {
+    strcpy(word, string);
+}
+
+const uint8_t SET_DATA[] = {
+        0x34, 0x12,              // u16
+        0x78, 0x56, 0x34, 0x12,  // u32
+        0xFE, 0xFF, 0xFF, 0xFF,  // s32
+};
+
+test(FrameTest, crc16) {
+    uint16_t crc = Frame::CRC_INIT;
+    for (auto p = "123456789"; *p; p++)
+        crc = Frame::crc16(crc, *p);
+    assertEqual(crc, (uint16_t)0x29B1);
+}
+
+test(FrameTest, dispatch) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    libcli::RingBuffer<64> ring;
+    cli.setInputRing(&ring);
+    libcli::FrameBuffer<16> framer(COMMANDS, 100);
+    cli.setFramer(&framer);
+
+    result = Result();
+    char buffer[10];
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+    put(ring, "ab");
+    uint8_t buf[32];
+    ring.put(buf, frame(buf, 0x10, SET_DATA, sizeof(SET_DATA)));
+    put(ring, "c ");
+    inject(cli);
+
+    assertEqual(stream.printerText(), "abc ");  // no echo of frame
+    assertEqual(word, "abc");
+    assertEqual(result.calls, 1);
+    assertEqual(result.id, (uint8_t)0x10);
+    assertEqual(result.size, (uint8_t)10);
+    assertEqual(result.u16, (uint16_t)0x1234);
+    assertEqual(result.u32, (uint32_t)0x12345678);
+    assertEqual(result.s32, (int32_t)-2);
+    assertEqual(result.context, (uintptr_t)100);
+    assertEqual(framer.errors(), (uint16_t)0);
+
+    ring.put(buf, frame(buf, 0x20, nullptr, 0));
+    inject(cli);
+    assertEqual(result.calls, 2);
+    assertEqual(result.id, (uint8_t)0x20);
+    assertEqual(result.size, (uint8_t)0);
+}
+
+test(FrameTest, errors) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    libcli::RingBuffer<128> ring;
+    cli.setInputRing(&ring);
+    libcli::FrameBuffer<8> framer(COMMANDS, 0);
+    cli.setFramer(&framer);
+
+    result = Result();
+    char buffer[10];
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+    uint8_t buf[32];
+    auto n = frame(buf, 0x20, SET_DATA, 4);
+    buf[n - 1] ^= 1;  // broken CRC
+    ring.put(buf, n);
+    ring.put(buf, frame(buf, 0x30, SET_DATA, 4));  // unknown id
+    ring.put(buf, frame(buf, 0x10, SET_DATA, 4));  // unexpected size
+    ring.put(buf, frame(buf, 0x20, SET_DATA, 10));  // too large
+    put(ring, "x ");
+    inject(cli, 80);
+
+    assertEqual(result.calls, 0);
+    assertEqual(framer.errors(), (uint16_t)4);
+    assertEqual(stream.printerText(), "x ");
+    assertEqual(word, "x");
+}
+
+test(FrameTest, timeout) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    libcli::RingBuffer<64> ring;
+    cli.setInputRing(&ring);
+    libcli::FrameBuffer<16> framer(COMMANDS, 0);
+    cli.setFramer(&framer);
+
+    char buffer[10];
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+    const uint8_t partial[] = {Frame::STX, 4, 0x20};
+    ring.put(partial, sizeof(partial));
+    inject(cli);
+    assertTrue(framer.receiving());
+
+    const auto start = millis();
+    while (millis() - start <= libcli::Framer::TIMEOUT_MS + 1)
+        ;
+    put(ring, "y ");
+    inject(cli);
+    assertFalse(framer.receiving());
+    assertEqual(framer.errors(), (uint16_t)1);
+    assertEqual(stream.printerText(), "y ");
+}
+
+test(FrameTest, ansi) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    libcli::RingBuffer<64> ring;
+    cli.setInputRing(&ring);
+    libcli::FrameBuffer<16> framer(COMMANDS, 0);
+    cli.setFramer(&framer);
+    cli.setAnsi(true);
+
+    result = Result();
+    char buffer[10];
+    cli.readLine(handleWord, 0, buffer, sizeof(buffer));
+    // Control-B moves cursor left, and a frame is accepted while editing.
+    put(ring, "ab\x02");
+    uint8_t buf[32];
+    ring.put(buf, frame(buf, 0x20, nullptr, 0));
+    put(ring, "X\x1b[D\x1b[DY\r");
+    inject(cli);
+
+    assertEqual(stream.printerText(), "ab\bXb\b\b\bYaXb\b\b\baXb ");
+    assertEqual(word, "YaXb");
+    assertEqual(result.calls, 1);
+    assertEqual(framer.errors(), (uint16_t)0);
+}
+
+test(FrameTest, send) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    const uint8_t data[] = {1, 2, 3};
+    assertEqual(cli.sendFrame(0x20, data, sizeof(data)), (size_t)(sizeof(data) + Frame::OVERHEAD));
+    uint8_t expected[16];
+    const auto n = frame(expected, 0x20, data, sizeof(data));
+    assertEqual(stream.printerLength(), (int)n);
+    assertEqual(memcmp(stream.printerText(), expected, n), 0);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 200) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+/** Collects loaded data into |memory|. */
+struct Image {
+    uint8_t memory[64];
+    uint32_t low = UINT32_MAX;
+    uint32_t high = 0;
+    uint32_t start = 0;
+    int calls = 0;
+    State state = State::CLI_SPACE;
+
+    static void sink(uint32_t address, const uint8_t *data, uint8_t size, uintptr_t context,
+            State state) {
+        auto &image = *reinterpret_cast<Image *>(context);
+        image.calls++;
+        image.state = state;
+        if (state == State::CLI_NEWLINE)
+            image.start = address;
+        if (state != State::CLI_CONTINUE)
+            return;
+        for (uint8_t i = 0; i < size; i++) {
+            const auto addr = address + i;
+            if (addr < image.low)
+                image.low = addr;
+            if (addr > image.high)
+                image.high = addr;
+            image.memory[addr & 0x3F] = data[i];
+        }
+    }
+    uintptr_t context() { return reinterpret_cast<uintptr_t>(this); }
+};
+
+test(LoaderTest, intelHex) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Image image;
+    libcli::LoaderBuffer<16> loader(Image::sink, image.context());
+    cli.readRecords(loader);
+    stream.setInput(
+            ":020000040001F9\r\n"
+            ":0400100001020304E2\r\n"
+            ":03001400aabbccB8\r\n"
+            ":0400000500010020D6\r\n"
+            ":00000001FF\r\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "");  // no echo
+    assertEqual(image.calls, 3);
+    assertEqual(loader.records(), (uint16_t)2);
+    assertEqual(loader.errors(), (uint16_t)0);
+    assertEqual(image.state, State::CLI_NEWLINE);
+    assertEqual(image.low, (uint32_t)0x10010);
+    assertEqual(image.high, (uint32_t)0x10016);
+    assertEqual(image.start, (uint32_t)0x10020);
+    assertEqual(image.memory[0x10], (uint8_t)1);
+    assertEqual(image.memory[0x13], (uint8_t)4);
+    assertEqual(image.memory[0x14], (uint8_t)0xAA);
+    assertEqual(image.memory[0x16], (uint8_t)0xCC);
+}
+
+test(LoaderTest, srecord) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Image image;
+    libcli::LoaderBuffer<16> loader(Image::sink, image.context());
+    cli.readRecords(loader);
+    stream.setInput(
+            "S00600004844521B\n"
+            "S1070020112233442E\n"
+            "S30700012345667700\n"  // wrong checksum
+            "S307000123456677B2\n"
+            "S5030002FA\n"
+            "S9030020DC\n");
+    inject(cli);
+    assertEqual(image.calls, 3);
+    assertEqual(loader.records(), (uint16_t)2);
+    assertEqual(loader.errors(), (uint16_t)1);
+    assertEqual(image.state, State::CLI_NEWLINE);
+    assertEqual(image.low, (uint32_t)0x20);
+    assertEqual(image.high, (uint32_t)0x12346);
+    assertEqual(image.start, (uint32_t)0x20);
+    assertEqual(image.memory[0x20], (uint8_t)0x11);
+    assertEqual(image.memory[0x23], (uint8_t)0x44);
+    assertEqual(image.memory[0x05], (uint8_t)0x66);
+    assertEqual(image.memory[0x06], (uint8_t)0x77);
+}
+
+test(LoaderTest, errors) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Image image;
+    libcli::LoaderBuffer<4> loader(Image::sink, image.context());
+    cli.readRecords(loader);
+    stream.setInput(
+            ":0400100001020304E3\r\n"  // wrong checksum
+            ":050010000102030405DC\r\n"  // too long for buffer
+            ":04001000010203\r\n"  // truncated
+            "S4030000FC\n"  // unknown type
+            ":0100000600F9\n"  // unknown Intel HEX type
+            ":02000000ABCD86\n");
+    inject(cli);
+    assertEqual(loader.errors(), (uint16_t)5);
+    assertEqual(loader.records(), (uint16_t)1);
+    assertEqual(image.calls, 1);
+    assertEqual(image.memory[0], (uint8_t)0xAB);
+    assertEqual(image.memory[1], (uint8_t)0xCD);
+
+    stream.setInput(":0200\x03");
+    inject(cli);
+    assertEqual(image.calls, 2);
+    assertEqual(image.state, State::CLI_CANCEL);
+}
+
+test(LoaderTest, cancel) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Image image;
+    libcli::LoaderBuffer<4> loader(Image::sink, image.context());
+    cli.readRecords(loader);
+    stream.setInput(
+            ":020000040001F9\n"  // extended linear address 0x10000
+            ":0100000000FE\n"    // wrong checksum
+            "\x03"
+            ":01000000AA55\n");
+    inject(cli, 60);
+    assertEqual(image.calls, 2);
+    assertEqual(image.state, State::CLI_CONTINUE);
+    // The extended address and counters of the canceled file are forgotten.
+    assertEqual(image.low, (uint32_t)0);
+    assertEqual(image.memory[0], (uint8_t)0xAA);
+    assertEqual(loader.errors(), (uint16_t)0);
+    assertEqual(loader.records(), (uint16_t)1);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
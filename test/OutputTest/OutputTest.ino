@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+
+#define NL "\r\n"
+#define BS "\b \b"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using NumberCallback = libcli::Cli::NumberCallback;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 10) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+test(OutputTest, buffered) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    assertEqual(cli.printHex(0x1234, 8), (size_t)8);
+    assertEqual(cli.printStr(F("abc"), -5), (size_t)5);
+    assertEqual(stream.printerText(), "");  // buffered
+    assertEqual(cli.availableForWrite(), 16 - 13);
+
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "00001234abc  ");  // sent at the end of loop
+    assertEqual(cli.availableForWrite(), 16);
+}
+
+test(OutputTest, newline) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    cli.print(F("abc"));
+    assertEqual(stream.printerText(), "");
+    cli.println();
+    assertEqual(stream.printerText(), "abc" NL);  // sent at newline
+}
+
+test(OutputTest, full) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[8];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    cli.print(F("0123456789"));
+    assertEqual(stream.printerText(), "01234567");  // sent when buffer is full
+    cli.print(F("ABCDEFGHIJ"));
+    assertEqual(stream.printerText(), "0123456789ABCDEF");
+    cli.write(reinterpret_cast<const uint8_t *>("abcdefghijklmnopq"), 17);
+    assertEqual(stream.printerText(), "0123456789ABCDEFGHIJabcdefghijkl");
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "0123456789ABCDEFGHIJabcdefghijklmnopq");
+}
+
+test(OutputTest, availableForWrite) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    stream.setAvailableForWrite(0);
+    cli.print(F("abcdef"));
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "");  // console is busy
+
+    stream.setAvailableForWrite(4);
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "abcd");  // sent as many as console can accept
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "abcdef");
+}
+
+test(OutputTest, flush) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    stream.setAvailableForWrite(0);
+    cli.print(F("abcdef"));
+    cli.setOutputBuffer(nullptr, 0);  // disabling buffer sends all
+    assertEqual(stream.printerText(), "abcdef");
+    cli.print(F("xyz"));
+    assertEqual(stream.printerText(), "abcdefxyz");  // unbuffered
+}
+
+/** Keeps output at flush to see what is sent before flushing console. */
+struct FlushStream : FakeStream {
+    void flush() override { flushed++; }
+    int flushed = 0;
+};
+
+test(OutputTest, flush_cli) {
+    FlushStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    stream.setAvailableForWrite(0);
+    cli.print(F("abcdef"));
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "");  // console is busy
+    cli.flush();
+    assertEqual(stream.printerText(), "abcdef");
+    assertEqual(stream.flushed, 1);
+}
+
+test(OutputTest, unpaced) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    // A console which never reports room, like Print's default availableForWrite.
+    stream.setAvailableForWrite(0);
+    uint8_t buffer[16];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    char line[10];
+    cli.readLine([](char *, uintptr_t, State) {}, 0, line, sizeof(line));
+    stream.setInput("ab\r");
+    inject(cli);
+    cli.print(F("result\n"));
+    assertEqual(stream.printerText(), "ab result\n");
+}
+
+struct Result {
+    uint32_t number;
+    State state;
+    bool valid = false;
+    uintptr_t context() { return reinterpret_cast<uintptr_t>(this); }
+    void set(uint32_t n, State s) {
+        number = n;
+        state = s;
+        valid = true;
+    }
+    static const NumberCallback callback;
+};
+
+const NumberCallback Result::callback = [](uint32_t number, uintptr_t context, State state) {
+    reinterpret_cast<Result *>(context)->set(number, state);
+};
+
+test(OutputTest, echo) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[32];
+    cli.setOutputBuffer(buffer, sizeof(buffer));
+
+    Result result;
+    cli.readHex(Result::callback, result.context(), UINT16_MAX, 0x1234);
+    assertEqual(stream.printerText(), "");
+    stream.setInput("\b\bab ");
+    cli.loop(0);
+    assertEqual(stream.printerText(), BS BS BS BS "1234" BS BS "ab" BS BS BS BS "12AB ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (uint32_t)0x12AB);
+}
+
+test(OutputTest, non_blocking) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[8];
+    cli.setOutputBuffer(buffer, sizeof(buffer), false);
+
+    stream.setAvailableForWrite(0);
+    assertEqual(cli.print(F("0123")), (size_t)4);
+    assertFalse(cli.backpressure());
+    assertEqual(cli.print(F("456789")), (size_t)4);  // doesn't block
+    assertEqual(stream.printerText(), "");
+    assertTrue(cli.backpressure());
+    assertEqual(cli.outputDropped(), (uint32_t)2);
+    assertEqual(cli.write('x'), (size_t)0);
+    assertEqual(cli.outputDropped(), (uint32_t)3);
+
+    stream.setAvailableForWrite(2);
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "01");
+    assertTrue(cli.backpressure());
+    inject(cli, 1);
+    assertEqual(stream.printerText(), "0123");
+    assertFalse(cli.backpressure());
+}
+
+test(OutputTest, deferred_echo) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    uint8_t buffer[8];
+    cli.setOutputBuffer(buffer, sizeof(buffer), false);
+
+    Result result;
+    cli.readHex(Result::callback, result.context(), UINT16_MAX);
+    stream.setAvailableForWrite(0);
+    cli.print(F("> "));
+    stream.setInput("1234 ");
+    assertEqual(cli.loop(0), (size_t)3);  // stops at backpressure
+    assertTrue(cli.backpressure());
+    assertEqual(cli.loop(0), (size_t)0);  // input is deferred
+    inject(cli);
+    assertEqual(stream.available(), 2);
+    assertEqual(stream.printerText(), "");
+
+    stream.setAvailableForWrite(INT16_MAX);
+    inject(cli);
+    assertEqual(stream.printerText(), "> 1234" BS BS BS BS "1234 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (uint32_t)0x1234);
+    assertEqual(cli.outputDropped(), (uint32_t)0);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
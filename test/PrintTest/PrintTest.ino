@@ -199,6 +199,57 @@ test(printTest, printlnNum) {
     stream.flush();
 }
 
+test(printTest, printNum_range) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    assertEqual(cli.printDec(0), (size_t)1);
+    assertEqual(stream.printerText(), "0");
+    stream.flush();
+
+    assertEqual(cli.printDec(UINT32_MAX), (size_t)10);
+    assertEqual(stream.printerText(), "4294967295");
+    stream.flush();
+
+    assertEqual(cli.printDec(1000000000), (size_t)10);
+    assertEqual(stream.printerText(), "1000000000");
+    stream.flush();
+
+    assertEqual(cli.printDec(999999999), (size_t)9);
+    assertEqual(stream.printerText(), "999999999");
+    stream.flush();
+
+    assertEqual(cli.printHex(0), (size_t)1);
+    assertEqual(stream.printerText(), "0");
+    stream.flush();
+
+    assertEqual(cli.printHex(UINT32_MAX), (size_t)8);
+    assertEqual(stream.printerText(), "FFFFFFFF");
+    stream.flush();
+
+    assertEqual(cli.printNum(UINT32_MAX, OCT), (size_t)11);
+    assertEqual(stream.printerText(), "37777777777");
+    stream.flush();
+
+    assertEqual(cli.printNum(UINT32_MAX, BIN), (size_t)32);
+    assertEqual(stream.printerText(), "11111111111111111111111111111111");
+    stream.flush();
+
+    assertEqual(cli.printNum(35, 36), (size_t)1);
+    assertEqual(stream.printerText(), "Z");
+    stream.flush();
+
+    assertEqual(cli.printNum(0x80000000, BIN, -40), (size_t)40);
+    assertEqual(stream.printerText(), "10000000000000000000000000000000        ");
+    stream.flush();
+
+    assertEqual(cli.printlnDec(1, 60), (size_t)62);
+    assertEqual(stream.printerText(),
+            "                                                           1" NL);
+    stream.flush();
+}
+
 test(printTest, printStr) {
     FakeStream stream;
     Cli cli;
@@ -355,6 +406,78 @@ test(printTest, printlnStr_P) {
     stream.flush();
 }
 
+LIBCLI_STR(STR_1234, "1234");
+LIBCLI_STR(STR_12345678, "12345678");
+LIBCLI_STR(STR_EMPTY, "");
+static const libcli::Str *const STR_TABLE[] PROGMEM = {&STR_1234, &STR_EMPTY, &STR_12345678};
+
+test(printTest, printStr_Str) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    assertEqual(STR_1234.length(), (uint8_t)4);
+    assertEqual(cli.printStr(STR_1234), (size_t)4);
+    assertEqual(stream.printerText(), "1234");
+    stream.flush();
+
+    assertEqual(cli.printStr(STR_1234, 8), (size_t)8);
+    assertEqual(stream.printerText(), "    1234");
+    stream.flush();
+
+    assertEqual(cli.printStr(STR_1234, -8), (size_t)8);
+    assertEqual(stream.printerText(), "1234    ");
+    stream.flush();
+
+    assertEqual(cli.printlnStr(STR_12345678, 4), (size_t)10);
+    assertEqual(stream.printerText(), "12345678" NL);
+    stream.flush();
+
+    assertEqual(cli.printStr(libcli::Str::at(STR_TABLE, 1), -3), (size_t)3);
+    assertEqual(stream.printerText(), "   ");
+    stream.flush();
+
+    assertEqual(cli.printlnStr(libcli::Str::at(STR_TABLE, 2), -10), (size_t)12);
+    assertEqual(stream.printerText(), "12345678  " NL);
+    stream.flush();
+}
+
+LIBCLI_FORMAT(FORMAT_ADD, "%d + %u = %-6d|\n");
+LIBCLI_FORMAT(FORMAT_RADIX, "%4x %o %8b 100%%");
+LIBCLI_FORMAT(FORMAT_STR, "[%s][%-5s][%5s][%c%3c]");
+LIBCLI_FORMAT(FORMAT_NONE, "text");
+
+static_assert(libcli::format::strings("%d %s %%%-3s%c") == 6, "strings of format");
+static_assert(libcli::format::Strings<int, const char *, char *>::bits() == 6, "strings of args");
+static_assert(libcli::format::Strings<const __FlashStringHelper *, char>::bits() == 1,
+        "strings of args");
+
+test(printTest, printFormat) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    assertEqual(cli.printFormat(FORMAT_ADD, -12, 34U, 22), (size_t)20);
+    assertEqual(stream.printerText(), "-12 + 34 = 22    |" NL);
+    stream.flush();
+
+    assertEqual(cli.printFormat(FORMAT_RADIX, 0xAB, 8, (uint8_t)5), (size_t)21);
+    assertEqual(stream.printerText(), "00AB 10 00000101 100%");
+    stream.flush();
+
+    cli.printFormat(FORMAT_RADIX, -1, 0, 0);
+    assertEqual(stream.printerText(), "FFFFFFFF 0 00000000 100%");
+    stream.flush();
+
+    cli.printFormat(FORMAT_STR, "ab", F("cd"), "ef", 'g', 'h');
+    assertEqual(stream.printerText(), "[ab][cd   ][   ef][g  h]");
+    stream.flush();
+
+    assertEqual(cli.printFormat(FORMAT_NONE), (size_t)4);
+    assertEqual(stream.printerText(), "text");
+    stream.flush();
+}
+
 test(printTest, backspace) {
     FakeStream stream;
     Cli cli;
@@ -379,6 +502,54 @@ test(printTest, backspace) {
     stream.flush();
 }
 
+/** Counts writes to check that a row is sent at once. */
+struct CountingStream : FakeStream {
+    size_t write(const uint8_t *data, size_t size) override {
+        writes++;
+        return FakeStream::write(data, size);
+    }
+    int writes = 0;
+};
+
+test(printTest, printDump) {
+    CountingStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    const uint8_t data[] = "0123456789ABCDEF\x01\x7f\xff";
+    assertEqual(cli.printDump(0x1234, data, 20), (size_t)(74 * 2));
+    assertEqual(stream.printerText(),
+            "1230:             30 31 32 33  34 35 36 37 38 39 41 42      0123456789AB" NL
+            "1240: 43 44 45 46 01 7F FF 00                           CDEF....        " NL);
+    assertEqual(stream.writes, 2);
+    stream.flush();
+
+    assertEqual(cli.printDump(0xFFFF0, data, 4, 6, 0, false), (size_t)21);
+    assertEqual(stream.printerText(), "0FFFF0: 30 31 32 33" NL);
+    stream.flush();
+
+    assertEqual(cli.printDump(0x2, data, 3, 0, 4, false), (size_t)18);
+    assertEqual(stream.printerText(), "       30 31  32" NL);
+    stream.flush();
+
+    assertEqual(cli.printDump(0, data, 0), (size_t)0);
+    assertEqual(stream.printerText(), "");
+}
+
+test(printTest, printDump_reader) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    const auto reader = [](uint32_t address, uintptr_t context) -> uint8_t {
+        return address + context;
+    };
+    assertEqual(cli.printDump(0x7E, 4, reader, 0x20, 2, 0), (size_t)(71 * 2));
+    assertEqual(stream.printerText(),
+            "70:                                           9E 9F                .." NL
+            "80: A0 A1                                            ..              " NL);
+}
+
 void setup() {}
 
 void loop() {
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+
+#define NL "\r\n"
+#define BS "\b \b"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 20) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+struct Result {
+    int32_t number;
+    State state;
+    bool valid = false;
+    uintptr_t context() { return Cli::Member<Result>::context(*this); }
+    void set(int32_t n, State s) {
+        number = n;
+        state = s;
+        valid = true;
+    }
+};
+
+const Cli::SignedCallback callback = Cli::Member<Result>::call<&Result::set>;
+
+test(ReadFixedTest, readFixed) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Result result;
+    cli.readFixed(callback, result.context(), 3, -99999, 99999);
+    stream.setInput("12.3754 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "12.375" BS BS BS BS BS BS " 12.375 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)12375);
+    assertEqual(result.state, State::CLI_SPACE);
+    stream.flush();
+
+    result.valid = false;
+    cli.readFixed(callback, result.context(), 3, -99999, 99999);
+    stream.setInput("-.5\r");
+    inject(cli);
+    assertEqual(stream.printerText(), "-.5" BS BS BS " -0.500 ");
+    assertEqual(result.number, (int32_t)-500);
+    assertEqual(result.state, State::CLI_NEWLINE);
+    stream.flush();
+
+    result.valid = false;
+    cli.readFixed(callback, result.context(), 2, 0, 1000);
+    stream.setInput("-7 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "7" BS "  7.00 ");
+    assertEqual(result.number, (int32_t)700);
+}
+
+test(ReadFixedTest, limit) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Result result;
+    // -1.28 to 1.27
+    cli.readFixed(callback, result.context(), 2, -128, 127);
+    stream.setInput("2");
+    inject(cli);
+    assertEqual(stream.printerText(), "");  // 2.00 exceeds
+    stream.setInput("1.28");
+    inject(cli);
+    assertEqual(stream.printerText(), "1.2");  // 1.28 exceeds
+    stream.setInput("7 ");
+    inject(cli);
+    assertEqual(result.number, (int32_t)127);
+    stream.flush();
+
+    cli.readFixed(callback, result.context(), 2, -128, 127);
+    stream.setInput("-1.298 ");  // -1.29 exceeds
+    inject(cli);
+    assertEqual(result.number, (int32_t)-128);
+}
+
+test(ReadFixedTest, range) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Result result;
+    cli.readFixed(callback, result.context(), 1, -500, -100);
+    stream.setInput("5-1 2.5\r");
+    inject(cli);
+    // 5 and space of -1, which is more than max, are not accepted.
+    assertEqual(stream.printerText(), "-12.5" BS BS BS BS BS "-12.5 ");
+    assertEqual(result.number, (int32_t)-125);
+}
+
+test(ReadFixedTest, backspace) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Result result;
+    cli.readFixed(callback, result.context(), 2, -10000, 10000);
+    stream.setInput("12.3\b\b\b\b45\r");
+    inject(cli);
+    assertEqual(stream.printerText(), "12.3" BS BS BS BS "45" BS BS "  45.00 ");
+    assertEqual(result.number, (int32_t)4500);
+    stream.flush();
+
+    result.valid = false;
+    cli.readFixed(callback, result.context(), 2, -10000, 10000);
+    stream.setInput("\b");
+    inject(cli);
+    assertTrue(result.valid);
+    assertEqual(result.state, State::CLI_DELETE);
+}
+
+test(ReadFixedTest, default) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    Result result;
+    cli.readFixed(callback, result.context(), 3, -99999, 99999, -1250);
+    assertEqual(stream.printerText(), BS BS BS BS BS BS BS "-1.250");
+    stream.flush();
+    stream.setInput("\b\b75\r");
+    inject(cli);
+    assertEqual(stream.printerText(), BS BS "75" BS BS BS BS BS BS " -1.275 ");
+    assertEqual(result.number, (int32_t)-1275);
+}
+
+test(ReadFixedTest, printFixed) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    assertEqual(cli.printFixed(12375, 3), (size_t)6);
+    assertEqual(stream.printerText(), "12.375");
+    stream.flush();
+
+    assertEqual(cli.printFixed(-5, 2, 7), (size_t)7);
+    assertEqual(stream.printerText(), "  -0.05");
+    stream.flush();
+
+    assertEqual(cli.printlnFixed(42, 0, -4), (size_t)6);
+    assertEqual(stream.printerText(), "42  " NL);
+    stream.flush();
+
+    cli.printFixed(INT32_MIN, 9);
+    assertEqual(stream.printerText(), "-2.147483648");
+    stream.flush();
+}
+
+test(ReadFixedTest, fractionMax) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    // No int32_t has more than 9 fraction digits.
+    assertEqual(cli.printFixed(1, 12), (size_t)11);
+    assertEqual(stream.printerText(), "0.000000001");
+    stream.flush();
+
+    Result result;
+    cli.readFixed(callback, result.context(), 12, -10, 10, -1);
+    assertEqual(stream.printerText(), BS BS BS BS BS BS BS BS BS BS BS BS "-0.000000001");
+    stream.flush();
+    stream.setInput("\b2\r");
+    inject(cli);
+    assertEqual(stream.printerText(), BS "2" BS BS BS BS BS BS BS BS BS BS BS BS "-0.000000002 ");
+    assertEqual(result.number, (int32_t)-2);
+}
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
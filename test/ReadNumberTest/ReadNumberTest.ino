@@ -524,6 +524,277 @@ test(ReadNumberTest, readNum_cancel) {
     assertEqual(result.state, State::CLI_CANCEL);
 }
 
+test(ReadNumberTest, readHex_member) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    using Member = libcli::Cli::Member<Result>;
+    Result result;
+    cli.readHex(Member::call<&Result::set>, Member::context(result), 0xFFF);
+    stream.setInput("1aB\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "1aB" BS BS BS "1AB ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (uint32_t)0x1AB);
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
+template <typename T>
+struct TypedResult {
+    T number;
+    State state;
+    bool valid = false;
+    uintptr_t context() { return libcli::Cli::Member<TypedResult>::context(*this); }
+    void set(T n, State s) {
+        number = n;
+        state = s;
+        valid = true;
+    }
+    static void callback(T number, uintptr_t context, State state) {
+        libcli::Cli::Member<TypedResult>::template call<&TypedResult::set>(number, context, state);
+    }
+};
+
+test(ReadNumberTest, readHex64) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<uint64_t> result;
+    cli.readHex(TypedResult<uint64_t>::callback, result.context());
+    stream.setInput("123456789abcdef01 ");
+    inject(cli, 20);
+    assertEqual(stream.printerText(),
+            "123456789abcdef0" BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS "123456789ABCDEF0 ");
+    assertTrue(result.valid);
+    assertTrue(result.number == 0x123456789ABCDEF0ULL);
+    assertEqual(result.state, State::CLI_SPACE);
+}
+
+test(ReadNumberTest, readDec64_limit) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<uint64_t> result;
+    cli.readDec(TypedResult<uint64_t>::callback, result.context(), 10000000000ULL);
+    stream.setInput("100000000009\n");
+    inject(cli, 20);
+    assertEqual(stream.printerText(),
+            "10000000000" BS BS BS BS BS BS BS BS BS BS BS "10000000000 ");
+    assertTrue(result.valid);
+    assertTrue(result.number == 10000000000ULL);
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
+test(ReadNumberTest, readBin64) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<uint64_t> result;
+    cli.readNum(TypedResult<uint64_t>::callback, result.context(), 2, UINT64_MAX);
+    char ones[65];
+    memset(ones, '1', 64);
+    ones[64] = 0;
+    stream.setInput(ones);
+    inject(cli, 70);
+    assertEqual(stream.printerText(), ones);
+    stream.flush();
+
+    stream.setInput("\n");
+    inject(cli);
+    char expected[64 * 3 + 64 + 2] = "";
+    for (auto i = 0; i < 64; i++)
+        strcat(expected, BS);
+    strcat(expected, ones);
+    strcat(expected, " ");
+    assertEqual(stream.printerText(), expected);
+    assertTrue(result.valid);
+    assertTrue(result.number == UINT64_MAX);
+    assertEqual(result.state, State::CLI_NEWLINE);
+
+    result.valid = false;
+    stream.flush();
+    // A default value is padded to 64 digits.
+    cli.readNum(TypedResult<uint64_t>::callback, result.context(), 2, UINT64_MAX, 5);
+    stream.setInput("\n");
+    inject(cli);
+    assertEqual(stream.printerLength(), 2 * (64 * 3 + 64) + 1);
+    assertTrue(result.valid);
+    assertTrue(result.number == 5);
+}
+
+test(ReadNumberTest, readDec64_defaultValue) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<uint64_t> result;
+    cli.readDec(TypedResult<uint64_t>::callback, result.context(), 99999999999ULL, 12345678901ULL);
+    assertEqual(stream.printerText(), BS BS BS BS BS BS BS BS BS BS BS "12345678901");
+    stream.flush();
+
+    stream.setInput("\b\b99 ");
+    inject(cli);
+    assertEqual(stream.printerText(),
+            BS BS "99" BS BS BS BS BS BS BS BS BS BS BS "12345678999 ");
+    assertTrue(result.valid);
+    assertTrue(result.number == 12345678999ULL);
+}
+
+test(ReadNumberTest, readDec_signed) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), -128, 127);
+    stream.setInput("1-29 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "12" BS BS "  12 ");  // '-' is accepted only at first
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)12);
+    assertEqual(result.state, State::CLI_SPACE);
+
+    stream.flush();
+    result.valid = false;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), -128, 127);
+    stream.setInput("--1298 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "-128" BS BS BS BS "-128 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)-128);
+    assertEqual(result.state, State::CLI_SPACE);
+
+    stream.flush();
+    result.valid = false;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), -128, 127);
+    stream.setInput("1287\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "127" BS BS BS " 127 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)127);
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
+test(ReadNumberTest, readDec_signed_unsigned) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), 0, 99);
+    stream.setInput("-1 ");
+    inject(cli);
+    assertEqual(stream.printerText(), "1" BS "  1 ");  // '-' is not accepted
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)1);
+}
+
+test(ReadNumberTest, readDec_signed_range) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), 10, 100);
+    stream.setInput("-5 0 ");
+    inject(cli);
+    // '-' and space of 5, which is less than min, are not accepted.
+    assertEqual(stream.printerText(), "50" BS BS "  50 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)50);
+
+    stream.flush();
+    result.valid = false;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), -100, -10);
+    stream.setInput("5-5 0 ");
+    inject(cli);
+    // 5 and space of -5, which is more than max, are not accepted.
+    assertEqual(stream.printerText(), "-50" BS BS BS " -50 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)-50);
+
+    stream.flush();
+    result.valid = false;
+    TypedResult<int64_t> result64;
+    cli.readDec(TypedResult<int64_t>::callback, result64.context(), -100, -10);
+    stream.setInput("0\n\b-10\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "0" BS "-10" BS BS BS " -10 ");
+    assertTrue(result64.number == -10);
+}
+
+test(ReadNumberTest, readDec_signed_defaultValue) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readDec(TypedResult<int32_t>::callback, result.context(), -1000, 1000, -5);
+    assertEqual(stream.printerText(), BS BS BS BS BS "-5");
+    stream.flush();
+
+    stream.setInput("\b7 ");
+    inject(cli);
+    assertEqual(stream.printerText(), BS "7" BS BS "   -7 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)-7);
+}
+
+test(ReadNumberTest, readDec_signed_delete) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readDec(TypedResult<int32_t>::callback, result.context());
+    stream.setInput("-1\b\b");
+    inject(cli);
+    assertEqual(stream.printerText(), "-1" BS BS);
+    assertFalse(result.valid);
+
+    stream.setInput("\b");
+    inject(cli);
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)0);
+    assertEqual(result.state, State::CLI_DELETE);
+}
+
+test(ReadNumberTest, readDec_signed64) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int64_t> result;
+    cli.readDec(TypedResult<int64_t>::callback, result.context());
+    stream.setInput("-92233720368547758089 ");
+    inject(cli, 30);
+    assertEqual(stream.printerText(),
+            "-9223372036854775808" BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS BS
+            BS "-9223372036854775808 ");
+    assertTrue(result.valid);
+    assertTrue(result.number == INT64_MIN);
+    assertEqual(result.state, State::CLI_SPACE);
+}
+
+test(ReadNumberTest, readNum_signed) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    TypedResult<int32_t> result;
+    cli.readNum(TypedResult<int32_t>::callback, result.context(), HEX, -0x80, 0x7F);
+    stream.setInput("-5\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "-5" BS BS "-05 ");
+    assertTrue(result.valid);
+    assertEqual(result.number, (int32_t)-5);
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
 void setup() {}
 
 void loop() {
@@ -310,6 +310,256 @@ test(ReadTextTest, readLine_cancel) {
     assertEqual(result.state, State::CLI_CANCEL);
 }
 
+test(ReadTextTest, loop_batch) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[20];
+    Result result;
+    cli.readLine(Result::callback, result.context(), buffer, sizeof(buffer));
+    assertEqual(cli.loop(0), (size_t)0);  // no input
+
+    stream.setInput("w1 w2 w3\n");
+    assertEqual(cli.loop(4), (size_t)4);  // byte count limit
+    assertEqual(stream.printerText(), "w1 w");
+    assertEqual(result.text, (char *)nullptr);  // no callback
+
+    assertEqual(cli.loop(0), (size_t)5);  // drain all
+    assertEqual(stream.printerText(), "w1 w2 w3 ");
+    assertEqual(result.text, "w1 w2 w3");
+    assertEqual(result.state, State::CLI_NEWLINE);
+    assertEqual(cli.loop(0), (size_t)0);  // no more input
+}
+
+test(ReadTextTest, loop_switch) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    static char buffer[20];
+    static Result result;
+    const LetterCallback callback = [](char, uintptr_t context) {
+        reinterpret_cast<Cli *>(context)->readLine(
+                Result::callback, result.context(), buffer, sizeof(buffer));
+    };
+    cli.readLetter(callback, reinterpret_cast<uintptr_t>(&cli));
+
+    stream.setInput("lw1 w2\n");
+    assertEqual(cli.loop(0, 1000000), (size_t)1);  // stop when readLine is requested
+    assertEqual(stream.printerText(), "");
+    assertEqual(cli.loop(0, 1000000), (size_t)6);
+    assertEqual(stream.printerText(), "w1 w2 ");
+    assertEqual(result.text, "w1 w2");
+    assertEqual(result.state, State::CLI_NEWLINE);
+}
+
+test(ReadTextTest, loop_idle) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    struct Idle {
+        Cli *cli;
+        int calls;
+        bool awake;
+    } idle{&cli, 0, false};
+    cli.setIdleHook(
+            [](uintptr_t context) {
+                auto &idle = *reinterpret_cast<Idle *>(context);
+                idle.calls++;
+                idle.awake = idle.cli->awake();
+            },
+            reinterpret_cast<uintptr_t>(&idle));
+
+    char buffer[20];
+    Result result;
+    cli.readLine(Result::callback, result.context(), buffer, sizeof(buffer));
+    assertEqual(cli.loop(), Cli::LoopStatus::CLI_IDLE);
+    assertEqual(idle.calls, 1);
+    assertFalse(idle.awake);
+
+    stream.setInput("ab\n");
+    assertEqual(cli.loop(), (Cli::LoopStatus)(Cli::LoopStatus::CLI_CONSUMED | Cli::LoopStatus::CLI_PENDING));
+    assertEqual(cli.loop(), (Cli::LoopStatus)(Cli::LoopStatus::CLI_CONSUMED | Cli::LoopStatus::CLI_PENDING));
+    assertEqual(cli.loop(), Cli::LoopStatus::CLI_CONSUMED);
+    assertEqual(idle.calls, 1);  // not idle while input is consumed
+    assertEqual(result.text, "ab");
+
+    assertEqual(cli.loop(0), (size_t)0);
+    assertEqual(idle.calls, 2);
+
+    // Waken by an interrupt handler while idle.
+    cli.wake();
+    assertTrue(cli.awake());
+    assertEqual(cli.loop(), Cli::LoopStatus::CLI_IDLE);
+    assertFalse(idle.awake);  // cleared by loop
+
+    cli.setIdleHook(nullptr, 0);
+    assertEqual(cli.loop(), Cli::LoopStatus::CLI_IDLE);
+    assertEqual(idle.calls, 3);
+}
+
+static constexpr const char *WORDS[] = {
+        "dump",
+        "help",
+        "load",
+        "step",
+        "stop",
+        "sub",
+        "subtract",
+};
+LIBCLI_TRIE(words, WORDS);
+
+test(ReadTextTest, readWord_complete) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[10];
+    Result result;
+    cli.readWord(Result::callback, result.context(), buffer, sizeof(buffer), words);
+    stream.setInput("h\t");
+    inject(cli);
+    assertEqual(stream.printerText(), "help");  // only suffix is echoed
+    assertEqual(buffer, "help");
+    stream.flush();
+
+    stream.setInput(" ");
+    inject(cli);
+    assertEqual(result.text, "help");
+    assertEqual(result.state, State::CLI_SPACE);
+    stream.flush();
+
+    cli.readWord(Result::callback, result.context(), buffer, sizeof(buffer), words);
+    stream.setInput("s\t");
+    inject(cli);
+    assertEqual(stream.printerText(), "s" NL "step stop sub subtract " NL "s");  // ambiguous
+    stream.flush();
+
+    stream.setInput("t\t");
+    inject(cli);
+    assertEqual(stream.printerText(), "t" NL "step stop " NL "st");
+    stream.flush();
+
+    stream.setInput("\b\bsu\t\t");
+    inject(cli);
+    assertEqual(stream.printerText(), BS BS "sub" NL "sub subtract " NL "sub");
+    stream.flush();
+
+    stream.setInput("t\t\r");
+    inject(cli);
+    assertEqual(stream.printerText(), "tract ");
+    assertEqual(result.text, "subtract");
+    assertEqual(result.state, State::CLI_NEWLINE);
+    stream.flush();
+
+    cli.readWord(Result::callback, result.context(), buffer, sizeof(buffer), words);
+    stream.setInput("x\t\t");
+    inject(cli);
+    assertEqual(stream.printerText(), "x");  // no candidates
+
+    // Tab terminates a word without completion.
+    cli.readWord(Result::callback, result.context(), buffer, sizeof(buffer));
+    stream.flush();
+    stream.setInput("ab\t");
+    inject(cli);
+    assertEqual(result.text, "ab");
+    assertEqual(result.state, State::CLI_SPACE);
+}
+
+struct Chunks {
+    char text[40] = "";
+    int calls = 0;
+    State state;
+    static void callback(char *chunk, uintptr_t context, State state) {
+        auto &chunks = *reinterpret_cast<Chunks *>(context);
+        chunks.calls++;
+        strcat(chunks.text, chunk);
+        if (state == State::CLI_CONTINUE)
+            strcat(chunks.text, "|");
+        chunks.state = state;
+    }
+};
+
+test(ReadTextTest, readChunks) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[5];
+    Chunks chunks;
+    cli.readChunks(Chunks::callback, reinterpret_cast<uintptr_t>(&chunks), buffer, sizeof(buffer));
+    stream.setInput("abcdefgh ij\b\b\bk\r");
+    inject(cli, 30);
+    assertEqual(chunks.text, "abcd|efgh|k");
+    assertEqual(chunks.calls, 3);
+    assertEqual(chunks.state, State::CLI_NEWLINE);
+    // No byte is dropped, and backspace stops at the start of the chunk.
+    assertEqual(stream.printerText(), "abcdefgh ij" BS BS BS "k ");
+
+    Chunks exact;
+    cli.readChunks(Chunks::callback, reinterpret_cast<uintptr_t>(&exact), buffer, sizeof(buffer));
+    stream.flush();
+    stream.setInput("1234\r");
+    inject(cli);
+    assertEqual(exact.text, "1234|");
+    assertEqual(exact.calls, 2);  // and an empty last chunk
+
+    // A callback may switch to another input with default value.
+    static char line[10];
+    static Chunks rearmed;
+    const StringCallback rearm = [](char *, uintptr_t context, State) {
+        strcpy(line, "dflt");
+        reinterpret_cast<Cli *>(context)->readLine(Chunks::callback,
+                reinterpret_cast<uintptr_t>(&rearmed), line, sizeof(line), true);
+    };
+    cli.readChunks(rearm, reinterpret_cast<uintptr_t>(&cli), buffer, sizeof(buffer));
+    stream.setInput("1234XY\r");
+    inject(cli);
+    assertEqual(rearmed.text, "dfltXY");
+    assertEqual(rearmed.state, State::CLI_NEWLINE);
+
+    Chunks cancel;
+    cli.readChunks(Chunks::callback, reinterpret_cast<uintptr_t>(&cancel), buffer, sizeof(buffer));
+    stream.setInput("12345\x03");
+    inject(cli);
+    assertEqual(cancel.text, "1234|5");
+    assertEqual(cancel.state, State::CLI_CANCEL);
+}
+
+test(ReadTextTest, readLine_ansi) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    cli.setAnsi(true);
+
+    char buffer[20];
+    Result result;
+    cli.readLine(Result::callback, result.context(), buffer, sizeof(buffer));
+    // Insert X, Y at home, delete a after right, and append ! at end.
+    stream.setInput("abcd\x1b[D\x1b[DX\x1b[1~Y\x1b[C\x7f\x1b[A\x1b[4~!\r");
+    inject(cli, 40);
+    assertEqual(stream.printerText(), "abcd\b\bXcd\b\b\b\b\bYabXcd\x1b[5Da\bbXcd\x1b[K\x1b[4DbXcd! ");
+    assertEqual(result.text, "YbXcd!");
+    assertEqual(result.state, State::CLI_NEWLINE);
+    stream.flush();
+
+    // A word is terminated wherever the cursor is.
+    cli.readWord(Result::callback, result.context(), buffer, sizeof(buffer));
+    stream.setInput("ab\x1bOD ");
+    inject(cli);
+    assertEqual(stream.printerText(), "ab\bb ");
+    assertEqual(result.text, "ab");
+    assertEqual(result.state, State::CLI_SPACE);
+    stream.flush();
+
+    // Erasing costs the same for any width.
+    assertEqual(cli.backspace(2), (size_t)6);
+    assertEqual(cli.backspace(12), (size_t)8);
+    assertEqual(stream.printerText(), BS BS "\x1b[12D\x1b[K");
+}
+
 void setup() {}
 
 void loop() {
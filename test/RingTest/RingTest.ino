@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 10) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+test(RingTest, put_read) {
+    libcli::RingBuffer<8> ring;
+    assertEqual(ring.available(), 0);
+    assertEqual(ring.read(), -1);
+    assertEqual(ring.peek(), -1);
+
+    assertTrue(ring.put('a'));
+    assertTrue(ring.put('b'));
+    assertEqual(ring.available(), 2);
+    assertEqual(ring.peek(), (int)'a');
+    assertEqual(ring.read(), (int)'a');
+    assertEqual(ring.read(), (int)'b');
+    assertEqual(ring.read(), -1);
+
+    // Wrap around.
+    for (auto i = 0; i < 20; i++) {
+        assertTrue(ring.put(i));
+        assertEqual(ring.read(), i);
+    }
+    assertEqual(ring.overflow(), (uint32_t)0);
+}
+
+test(RingTest, overflow) {
+    libcli::RingBuffer<8> ring;
+    for (auto i = 0; i < 7; i++)
+        assertTrue(ring.put('0' + i));
+    assertEqual(ring.available(), 7);
+    assertFalse(ring.put('x'));
+    assertEqual(ring.overflow(), (uint32_t)1);
+
+    assertEqual(ring.read(), (int)'0');
+    const uint8_t data[] = {'a', 'b', 'c', 'd'};
+    assertEqual(ring.put(data, sizeof(data)), (size_t)1);
+    assertEqual(ring.overflow(), (uint32_t)4);
+    for (auto i = 1; i < 7; i++)
+        assertEqual(ring.read(), (int)'0' + i);
+    assertEqual(ring.read(), (int)'a');
+
+    ring.put('z');
+    ring.clear();
+    assertEqual(ring.available(), 0);
+    assertEqual(ring.overflow(), (uint32_t)0);
+}
+
+char word[20];
+int words;
+
+void handleWord(char *string, uintptr_t, State) {
+    strcpy(word, string);
+    words++;
+}
+
+test(RingTest, cli) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+    libcli::RingBuffer<64> ring;
+    cli.setInputRing(&ring);
+
+    char buffer[10];
+    words = 0;
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+    stream.setInput("console ");
+    const char text[] = "type-ahead ";
+    ring.put(reinterpret_cast<const uint8_t *>(text), strlen(text));
+    assertEqual(cli.available(), 11);
+    inject(cli, 20);
+    assertEqual(stream.printerText(), "type-ahea ");
+    assertEqual(word, "type-ahea");
+    assertEqual(words, 1);
+    assertEqual(stream.available(), 8);  // console is untouched
+
+    cli.setInputRing(nullptr);
+    cli.readWord(handleWord, 0, buffer, sizeof(buffer));
+    inject(cli, 20);
+    assertEqual(word, "console");
+    assertEqual(words, 2);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+#define NL "\r\n"
+#define BS "\b \b"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+void inject(Cli &cli, int n = 40) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+Cli cli;
+
+void handleCommand(char letter, uintptr_t context);
+
+void prompt() {
+    cli.print(F("> "));
+    cli.readLetter(handleCommand, 0);
+}
+
+void handleAdd(uint32_t value, uintptr_t context, State state) {
+    static uint32_t left;
+    if (state == State::CLI_CANCEL) {
+        prompt();
+        return;
+    }
+    if (context == 0) {
+        left = value;
+        cli.readDec(handleAdd, 1, UINT16_MAX);
+        return;
+    }
+    cli.println();
+    cli.printlnDec(left + value);
+    prompt();
+}
+
+void handleCommand(char letter, uintptr_t) {
+    if (letter == 'a') {
+        cli.print(F("add "));
+        cli.readDec(handleAdd, 0, UINT16_MAX);
+        return;
+    }
+    prompt();
+}
+
+test(ScriptTest, ram) {
+    FakeStream stream;
+    cli.begin(stream);
+    prompt();
+    stream.flush();
+
+    const char script[] = "a12 34\na1\b5 6\n";
+    cli.runScript(script);
+    assertTrue(cli.scriptRunning());
+    assertEqual(cli.available(), 1);
+    inject(cli);
+    assertFalse(cli.scriptRunning());
+    assertEqual(stream.printerText(), "add " NL "46" NL "> add " NL "11" NL "> ");
+
+    // Back to console with echo.
+    stream.flush();
+    stream.setInput("a7 8\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "add 7" BS "    7 8" BS "    8 " NL "15" NL "> ");
+}
+
+test(ScriptTest, progmem) {
+    FakeStream stream;
+    cli.begin(stream);
+    prompt();
+    stream.flush();
+
+    cli.runScript(F("a12\x03" "a3 4\n"));
+    stream.setInput("a");  // console input waits for the end of script
+    inject(cli);
+    assertFalse(cli.scriptRunning());
+    assertEqual(stream.printerText(), "add > add " NL "7" NL "> add ");
+}
+
+test(ScriptTest, empty) {
+    FakeStream stream;
+    cli.begin(stream);
+    prompt();
+    cli.runScript("");
+    assertFalse(cli.scriptRunning());
+    stream.setInput("a");
+    inject(cli);
+    assertEqual(stream.printerText(), "> add ");
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+using Cli = libcli::Cli;
+using Sessions = libcli::Sessions<3>;
+using FakeStream = libcli::fake::FakeStream;
+
+// The manager adds |_current|, idle hook and its context, and two bytes.
+static_assert(sizeof(Sessions) <= 3 * sizeof(Cli) + 4 * sizeof(void *), "per session cost");
+
+Sessions sessions;
+char letters[40];
+
+void append(const char *text) {
+    strcat(letters, text);
+}
+
+void handleLetter(char letter, uintptr_t context) {
+    // Echo back to own session and read next.
+    auto cli = sessions.current();
+    const char text[] = {char('0' + context), letter, 0};
+    append(text);
+    cli->print(letter);
+    cli->readLetter(handleLetter, context);
+}
+
+test(SessionsTest, round_robin) {
+    FakeStream streams[Sessions::size()];
+    letters[0] = 0;
+    for (uint8_t i = 0; i < Sessions::size(); i++) {
+        sessions.begin(i, streams[i]);
+        sessions[i].readLetter(handleLetter, i);
+    }
+    streams[0].setInput("abcd");
+    streams[1].setInput("x");
+    streams[2].setInput("pq");
+
+    assertEqual(sessions.loop(), (size_t)3);
+    assertEqual(letters, "0a1x2p");
+    assertEqual(sessions.current(), (Cli *)nullptr);
+
+    // Next round starts from session 1.
+    assertEqual(sessions.loop(), (size_t)2);
+    assertEqual(letters, "0a1x2p2q0b");
+
+    assertEqual(sessions.loop(10), (size_t)2);
+    assertEqual(letters, "0a1x2p2q0b0c0d");
+    assertEqual(sessions.loop(10), (size_t)0);
+
+    assertEqual(streams[0].printerText(), "abcd");
+    assertEqual(streams[1].printerText(), "x");
+    assertEqual(streams[2].printerText(), "pq");
+}
+
+test(SessionsTest, independent) {
+    FakeStream streams[Sessions::size()];
+    char buffer0[10], buffer1[10];
+    letters[0] = 0;
+    for (uint8_t i = 0; i < Sessions::size(); i++)
+        sessions.begin(i, streams[i]);
+    sessions[0].readWord(
+            [](char *word, uintptr_t, libcli::State) { append(word); }, 0, buffer0,
+            sizeof(buffer0));
+    sessions[1].readWord(
+            [](char *word, uintptr_t, libcli::State) { append(word); }, 0, buffer1,
+            sizeof(buffer1));
+    sessions[2].readLetter(handleLetter, 2);
+    streams[0].setInput("ab ");
+    streams[1].setInput("cd\n");
+    streams[2].setInput("e");
+
+    assertEqual(sessions.loop(5), (size_t)7);
+    assertEqual(letters, "2eabcd");
+    assertEqual(streams[0].printerText(), "ab ");
+    assertEqual(streams[1].printerText(), "cd ");
+    assertEqual(streams[2].printerText(), "e");
+}
+
+int idles;
+
+test(SessionsTest, idle) {
+    FakeStream streams[Sessions::size()];
+    letters[0] = 0;
+    for (uint8_t i = 0; i < Sessions::size(); i++) {
+        sessions.begin(i, streams[i]);
+        sessions[i].readLetter(handleLetter, i);
+    }
+    idles = 0;
+    sessions.setIdleHook([](uintptr_t context) { idles += context; }, 1);
+    streams[2].setInput("ab");
+
+    // Idle sessions don't call the hook while another one has input.
+    assertEqual(sessions.loop(), (size_t)1);
+    assertEqual(idles, 0);
+    assertEqual(sessions.loop(), (size_t)1);
+    assertEqual(idles, 0);
+    assertEqual(sessions.loop(), (size_t)0);
+    assertEqual(idles, 1);
+    assertEqual(letters, "2a2b");
+
+    sessions.wake();
+    assertTrue(sessions.awake());
+    sessions.loop();
+    assertFalse(sessions.awake());
+    assertEqual(idles, 2);
+    sessions.setIdleHook(nullptr, 0);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+#define NL "\r\n"
+
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+using Histogram = libcli::Histogram;
+
+void inject(Cli &cli, int n = 10) {
+    while (--n >= 0)
+        cli.loop();
+}
+
+uint32_t total(const Histogram &h) {
+    uint32_t n = 0;
+    for (auto c : h.count)
+        n += c;
+    return n;
+}
+
+void busy(uint32_t us) {
+    const auto start = micros();
+    while (micros() - start < us)
+        ;
+}
+
+void handleLetter(char, uintptr_t) {}
+
+void handleString(char *, uintptr_t, State) {}
+
+void handleNumber(uint32_t, uintptr_t, State) {
+    busy(100);
+}
+
+test(StatsTest, histogram) {
+    Histogram h = Histogram();
+    h.add(0);
+    h.add(1);
+    h.add(3);
+    h.add(4);
+    h.add(100);
+    h.add(5000);
+    h.add(100000);
+    assertEqual(h.count[0], (uint32_t)1);
+    assertEqual(h.count[1], (uint32_t)2);
+    assertEqual(h.count[2], (uint32_t)1);
+    assertEqual(h.count[4], (uint32_t)1);
+    assertEqual(h.count[7], (uint32_t)2);
+    assertEqual(h.max, (uint32_t)100000);
+    assertEqual(Histogram::lower(0), (uint32_t)0);
+    assertEqual(Histogram::lower(1), (uint32_t)1);
+    assertEqual(Histogram::lower(4), (uint32_t)64);
+    assertEqual(Histogram::lower(7), (uint32_t)4096);
+}
+
+test(StatsTest, bytes) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    char buffer[5];
+    cli.readWord(handleString, 0, buffer, sizeof(buffer));
+    stream.setInput("abcdefg\n");
+    inject(cli);
+    assertEqual(stream.printerText(), "abcd ");
+
+    auto &stats = cli.stats();
+    assertEqual(stats.bytesIn, (uint32_t)8);
+    assertEqual(stats.bytesOut, (uint32_t)5);
+    assertEqual(stats.dropped, (uint32_t)3);
+    assertEqual(stats.states[State::CLI_NEWLINE], (uint32_t)1);
+    assertEqual(total(stats.loops), (uint32_t)8);
+    assertEqual(total(stats.callbacks), (uint32_t)1);
+
+    cli.resetStats();
+    assertEqual(cli.stats().bytesIn, (uint32_t)0);
+    assertEqual(cli.stats().bytesOut, (uint32_t)0);
+    assertEqual(total(cli.stats().loops), (uint32_t)0);
+}
+
+test(StatsTest, callbacks) {
+    FakeStream stream;
+    Cli cli;
+    cli.begin(stream);
+
+    cli.readLetter(handleLetter, 0);
+    stream.setInput('a');
+    inject(cli);
+    assertEqual(cli.stats().letters, (uint32_t)1);
+
+    cli.readHex(handleNumber, 0, 0xFF);
+    stream.setInput("1x23\x03");
+    assertEqual(cli.loop(10), (size_t)5);
+    assertEqual(stream.printerText(), "12 cancel" NL);
+
+    auto &stats = cli.stats();
+    assertEqual(stats.dropped, (uint32_t)2);  // 'x' and '3'
+    assertEqual(stats.states[State::CLI_CANCEL], (uint32_t)1);
+    assertEqual(total(stats.callbacks), (uint32_t)2);
+    assertMore(stats.callbacks.max, (uint32_t)99);
+    assertEqual(total(stats.loops), (uint32_t)2);  // loop() and loop(10)
+    assertMore(stats.loops.max, (uint32_t)99);
+}
+
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4:
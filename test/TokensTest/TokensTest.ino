@@ -0,0 +1,174 @@
+/*
+ * Copyright 2026 Tadashi G. Takaoka
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+
+#include <AUnit.h>
+
+#include <libcli.h>
+#include <libcli/fake/FakeStream.h>
+using Cli = libcli::Cli;
+using State = libcli::Cli::State;
+using FakeStream = libcli::fake::FakeStream;
+
+test(TokensTest, split) {
+    Cli::Tokens<4> tokens;
+    char line[] = "  set  addr 1234 ";
+    assertEqual(tokens.split(line), 3);
+    assertEqual(tokens.size(), (size_t)3);
+    assertEqual(tokens[0].text, "set");
+    assertEqual(tokens[0].len, (size_t)3);
+    assertEqual(tokens[1].text, "addr");
+    assertEqual(tokens[2].text, "1234");
+    assertEqual(tokens[2].len, (size_t)4);
+    // Views point into the line.
+    assertTrue(tokens[0].text == line + 2);
+
+    char empty[] = "   ";
+    assertEqual(tokens.split(empty), 0);
+    assertEqual(tokens.size(), (size_t)0);
+
+    char many[] = "a b c d e";
+    assertEqual(tokens.split(many), -1);
+}
+
+test(TokensTest, quote) {
+    Cli::Tokens<4> tokens;
+    char line[] = "echo \"hello world\" 'it''s'";
+    assertEqual(tokens.split(line), 4);
+    assertEqual(tokens[0].text, "echo");
+    assertEqual(tokens[1].text, "hello world");
+    assertEqual(tokens[1].len, (size_t)11);
+    assertEqual(tokens[2].text, "it");
+    assertEqual(tokens[3].text, "s");
+    // Second ' quotes "s" just after the first token.
+
+    char escape[] = "\"a\\\"b\\\\\" ''";
+    assertEqual(tokens.split(escape), 2);
+    assertEqual(tokens[0].text, "a\"b\\");
+    assertEqual(tokens[0].len, (size_t)4);
+    assertEqual(tokens[1].text, "");
+    assertEqual(tokens[1].len, (size_t)0);
+
+    char unterminated[] = "echo \"abc";
+    assertEqual(tokens.split(unterminated), -1);
+}
+
+test(TokensTest, number) {
+    Cli::Tokens<8> tokens;
+    char line[] = "ffff 10000 65535 65536 12x 0 zz 101";
+    assertEqual(tokens.split(line), 8);
+    uint32_t value = 0;
+    assertTrue(tokens.hex(0, value, UINT16_MAX));
+    assertEqual(value, (uint32_t)0xFFFF);
+    assertFalse(tokens.hex(1, value, UINT16_MAX));
+    assertEqual(value, (uint32_t)0xFFFF);
+    assertTrue(tokens.hex(1, value));
+    assertEqual(value, (uint32_t)0x10000);
+    assertTrue(tokens.dec(2, value, UINT16_MAX));
+    assertEqual(value, (uint32_t)65535);
+    assertFalse(tokens.dec(3, value, UINT16_MAX));
+    assertFalse(tokens.dec(4, value));
+    assertTrue(tokens.dec(5, value));
+    assertEqual(value, (uint32_t)0);
+    assertTrue(tokens.num(6, 36, value));
+    assertEqual(value, (uint32_t)(35 * 36 + 35));
+    assertTrue(tokens.num(7, 2, value));
+    assertEqual(value, (uint32_t)5);
+    assertFalse(tokens.num(7, 2, value, 4));
+    assertFalse(tokens.dec(8, value));
+
+    char wide[] = "ffffffffffffffff 10000000000000000 4294967295 4294967296";
+    assertEqual(tokens.split(wide), 4);
+    uint64_t value64 = 0;
+    assertTrue(tokens.num(0, 16, value64));
+    assertTrue(value64 == UINT64_MAX);
+    assertFalse(tokens.num(1, 16, value64));
+    assertTrue(tokens.dec(2, value));
+    assertEqual(value, UINT32_MAX);
+    assertFalse(tokens.dec(3, value));
+}
+
+test(TokensTest, signed_number) {
+    Cli::Tokens<8> tokens;
+    char line[] = "-128 127 -129 128 - -0 2147483647 -2147483648";
+    assertEqual(tokens.split(line), 8);
+    int32_t value = 0;
+    assertTrue(tokens.dec(0, value, INT8_MIN, INT8_MAX));
+    assertEqual(value, (int32_t)-128);
+    assertTrue(tokens.dec(1, value, INT8_MIN, INT8_MAX));
+    assertEqual(value, (int32_t)127);
+    assertFalse(tokens.dec(2, value, INT8_MIN, INT8_MAX));
+    assertFalse(tokens.dec(3, value, INT8_MIN, INT8_MAX));
+    assertFalse(tokens.dec(4, value));
+    assertTrue(tokens.dec(5, value));
+    assertEqual(value, (int32_t)0);
+    assertFalse(tokens.dec(5, value, 1, 10));
+    assertTrue(tokens.dec(6, value));
+    assertEqual(value, INT32_MAX);
+    assertTrue(tokens.dec(7, value));
+    assertEqual(value, INT32_MIN);
+    assertFalse(tokens.dec(7, value, -10, 10));
+}
+
+test(TokensTest, keyword) {
+    Cli::Tokens<4> tokens;
+    char line[] = "set reset se sets";
+    assertEqual(tokens.split(line), 4);
+    assertEqual(tokens.keyword(0, F("get|set|reset")), 1);
+    assertEqual(tokens.keyword(1, F("get|set|reset")), 2);
+    assertEqual(tokens.keyword(2, F("get|set|reset")), -1);
+    assertEqual(tokens.keyword(3, F("get|set|reset")), -1);
+    assertEqual(tokens.keyword(0, F("set")), 0);
+    assertEqual(tokens.keyword(4, F("set")), -1);
+}
+
+char buffer[40];
+int parsed;
+
+void handleLine(char *line, uintptr_t context, State) {
+    auto &tokens = *reinterpret_cast<Cli::Tokens<4> *>(context);
+    uint32_t addr, len;
+    if (tokens.split(line) == 3 && tokens.keyword(0, F("dump|fill")) == 0 &&
+            tokens.hex(1, addr, UINT16_MAX) && tokens.dec(2, len, 256)) {
+        parsed = addr + len;
+    }
+}
+
+test(TokensTest, read_line) {
+    FakeStream console;
+    Cli cli;
+    cli.begin(console);
+    Cli::Tokens<4> tokens;
+    parsed = 0;
+    console.setInput("dump 1000 16\r");
+    cli.readLine(handleLine, reinterpret_cast<uintptr_t>(&tokens), buffer, sizeof(buffer));
+    for (auto n = 0; n < 20; n++)
+        cli.loop();
+    assertEqual(parsed, 0x1000 + 16);
+}
+void setup() {}
+
+void loop() {
+    aunit::TestRunner::run();
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+// vim: set ft=cpp et ts=4 sw=4: